@@ -39,24 +39,63 @@ extern "C" {
 
 
 bool _wifi_libnet_init(void);
+bool _wifi_libnet_init_with_event_thread(void *callback_context);
+bool _wifi_libnet_init_with_event_fd(int *fd);
+int _wifi_libnet_dispatch_pending(void);
 bool _wifi_libnet_deinit(void);
 int _wifi_activate(void);
 int _wifi_deactivate(void);
 
 bool _wifi_libnet_check_ap_validity(wifi_ap_h ap_h);
-void _wifi_libnet_add_to_ap_list(wifi_ap_h ap_h);
+net_profile_info_t *_wifi_libnet_get_ap_info(wifi_ap_h ap_h);
+wifi_ap_h _wifi_libnet_add_to_ap_list(net_profile_info_t *ap_info);
 void _wifi_libnet_remove_from_ap_list(wifi_ap_h ap_h);
+wifi_ap_h _wifi_libnet_clone_ap(wifi_ap_h ap_h);
+net_profile_info_t *_wifi_libnet_get_ap_info_for_write(wifi_ap_h ap_h);
+int _wifi_libnet_begin_edit(wifi_ap_h ap_h);
+bool _wifi_libnet_mark_ap_dirty(wifi_ap_h ap_h);
+int _wifi_libnet_commit_edit(wifi_ap_h ap_h);
+int _wifi_libnet_commit_edit_async(wifi_ap_h ap_h, wifi_ap_committed_cb callback, void *user_data);
 bool _wifi_libnet_check_profile_name_validity(const char *profile_name);
 
+net_profile_info_t *_wifi_libnet_alloc_ap_info(void);
+void _wifi_libnet_free_ap_info(net_profile_info_t *ap_info);
+void _wifi_libnet_set_ap_pool_size(int size);
+void _wifi_libnet_get_ap_pool_stats(wifi_ap_pool_stats_s *stats);
+void _wifi_libnet_get_event_latency_stats(wifi_event_latency_stats_s *stats);
+void _wifi_libnet_reset_event_latency_stats(void);
+void _wifi_libnet_set_state_event_window(int window_ms);
+void _wifi_libnet_get_state_event_stats(wifi_state_event_stats_s *stats);
+
 bool _wifi_libnet_get_wifi_state(wifi_connection_state_e* connection_state);
 int _wifi_libnet_get_intf_name(char** name);
 int _wifi_libnet_scan_request(wifi_scan_finished_cb callback, void* user_data);
 int _wifi_libnet_get_connected_profile(wifi_ap_h *ap);
+int _wifi_libnet_get_ap_by_bssid(const char *bssid, wifi_ap_h *ap);
+int _wifi_libnet_get_ap_by_profile_name(const char *profile_name, wifi_ap_h *ap);
+int _wifi_libnet_get_ap_by_essid(const char *essid, wifi_ap_h **aps, int *count);
 bool _wifi_libnet_foreach_found_aps(wifi_found_ap_cb callback, void *user_data);
+bool _wifi_libnet_foreach_found_aps_sorted(wifi_ap_sort_key_e key, int max_count,
+		wifi_found_ap_cb callback, void *user_data);
+bool _wifi_libnet_foreach_found_aps_filtered(const wifi_ap_filter_s *filter,
+		wifi_found_ap_cb callback, void *user_data);
+bool _wifi_libnet_benchmark_profile_summary(int count, int iterations,
+		long long *profile_us, long long *summary_us);
+bool _wifi_libnet_foreach_changed_aps(wifi_changed_ap_cb callback, void *user_data);
+int _wifi_libnet_export_found_aps(wifi_ap_info_s *buf, int size, int *count);
+int _wifi_libnet_export_found_aps_alloc(wifi_ap_info_s **buf, int *count);
+void _wifi_libnet_set_scan_cache_path(const char *path);
+bool _wifi_libnet_is_scan_result_stale(void);
 
 int _wifi_libnet_open_profile(wifi_ap_h ap_h);
 int _wifi_libnet_close_profile(wifi_ap_h ap_h);
 int _wifi_libnet_connect_with_wps(wifi_ap_h ap_h, wifi_wps_type_e type, const char *pin);
+int _wifi_libnet_open_profile_async(wifi_ap_h ap_h, wifi_request_completed_cb callback,
+		void *user_data, int *request_id);
+int _wifi_libnet_close_profile_async(wifi_ap_h ap_h, wifi_request_completed_cb callback,
+		void *user_data, int *request_id);
+int _wifi_libnet_connect_with_wps_async(wifi_ap_h ap_h, wifi_wps_type_e type, const char *pin,
+		wifi_request_completed_cb callback, void *user_data, int *request_id);
 
 int _wifi_set_power_on_off_cb(wifi_device_state_changed_cb callback, void *user_data);
 int _wifi_unset_power_on_off_cb(void);
@@ -66,6 +105,11 @@ int _wifi_set_connection_state_cb(wifi_connection_state_changed_cb callback, voi
 int _wifi_unset_connection_state_cb();
 
 int _wifi_update_ap_info(net_profile_info_t *ap_info);
+void _wifi_fill_ap_info(net_profile_info_t *profile_info, wifi_ap_info_s *info, unsigned int field_mask);
+void _wifi_restore_ap_info(const wifi_ap_info_s *info, net_profile_info_t *profile_info);
+
+int _wifi_scan_cache_store(const char *path, const wifi_ap_info_s *records, int count);
+int _wifi_scan_cache_load(const char *path, net_profile_info_t **profiles, int *count);
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -40,6 +40,7 @@ typedef enum
     WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED = TIZEN_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED, /**< Address family not supported */
     WIFI_ERROR_OPERATION_FAILED = TIZEN_ERROR_NETWORK_CLASS|0x0301, /**< Operation failed */
     WIFI_ERROR_NO_CONNECTION = TIZEN_ERROR_NETWORK_CLASS|0x0302, /**< There is no connected AP */
+    WIFI_ERROR_AP_NOT_FOUND = TIZEN_ERROR_NETWORK_CLASS|0x0303, /**< There is no matching AP */
 } wifi_error_e;
 
 /**
@@ -83,6 +84,73 @@ typedef enum
     WIFI_RSSI_LEVEL_4 = 4,  /**< level 4 */
 } wifi_rssi_level_e;
 
+/**
+* @brief The type of change of an access point between two scan results
+*/
+typedef enum
+{
+    WIFI_AP_CHANGE_TYPE_ADDED = 0,  /**< The access point is newly found */
+    WIFI_AP_CHANGE_TYPE_REMOVED = 1,  /**< The access point is not found any more */
+    WIFI_AP_CHANGE_TYPE_UPDATED = 2,  /**< The attributes of the access point are changed */
+} wifi_ap_change_type_e;
+
+/**
+* @brief The attributes of an access point, used as bit flags
+*/
+typedef enum
+{
+    WIFI_AP_FIELD_ESSID = 0x0001,  /**< ESSID */
+    WIFI_AP_FIELD_BSSID = 0x0002,  /**< BSSID */
+    WIFI_AP_FIELD_RSSI = 0x0004,  /**< RSSI */
+    WIFI_AP_FIELD_FREQUENCY = 0x0008,  /**< Frequency */
+    WIFI_AP_FIELD_MAX_SPEED = 0x0010,  /**< Max speed */
+    WIFI_AP_FIELD_FAVORITE = 0x0020,  /**< Favorite */
+    WIFI_AP_FIELD_CONNECTION_STATE = 0x0040,  /**< Connection state */
+    WIFI_AP_FIELD_SECURITY_TYPE = 0x0080,  /**< Security type */
+    WIFI_AP_FIELD_ENCRYPTION_TYPE = 0x0100,  /**< Encryption type */
+    WIFI_AP_FIELD_PASSPHRASE_REQUIRED = 0x0200,  /**< Whether passphrase is required */
+    WIFI_AP_FIELD_WPS_SUPPORTED = 0x0400,  /**< Whether WPS is supported */
+    WIFI_AP_FIELD_ALL = 0x07FF,  /**< All of the above */
+} wifi_ap_field_e;
+
+/**
+* @brief The key to order the found access points
+*/
+typedef enum
+{
+    WIFI_AP_SORT_KEY_RSSI = 0,  /**< The strongest RSSI first */
+    WIFI_AP_SORT_KEY_FREQUENCY = 1,  /**< The lowest frequency first */
+    WIFI_AP_SORT_KEY_MAX_SPEED = 2,  /**< The highest max speed first */
+    WIFI_AP_SORT_KEY_ESSID = 3,  /**< ESSID in byte order */
+} wifi_ap_sort_key_e;
+
+/**
+* @brief The criteria of #wifi_ap_filter_s, used as bit flags
+*/
+typedef enum
+{
+    WIFI_AP_FILTER_FREQUENCY = 0x01,  /**< The frequency is in [min_frequency, max_frequency] */
+    WIFI_AP_FILTER_SECURITY_TYPE = 0x02,  /**< The security type is in security_types */
+    WIFI_AP_FILTER_RSSI = 0x04,  /**< The RSSI is min_rssi or more */
+    WIFI_AP_FILTER_FAVORITE = 0x08,  /**< Whether the access point is favorite equals favorite */
+    WIFI_AP_FILTER_WPS_SUPPORTED = 0x10,  /**< Whether WPS is supported equals wps_supported */
+} wifi_ap_filter_flag_e;
+
+/**
+* @brief The filter of found access points
+* @details Only the criteria selected in @a flags are evaluated. An access point must meet all of them.
+*/
+typedef struct
+{
+    unsigned int flags;  /**< The criteria to evaluate, as a bitwise OR of #wifi_ap_filter_flag_e */
+    int min_frequency;  /**< The lowest frequency (MHz) */
+    int max_frequency;  /**< The highest frequency (MHz) */
+    unsigned int security_types;  /**< The allowed security types, as a bitwise OR of (1 << #wifi_security_type_e) */
+    int min_rssi;  /**< The lowest RSSI */
+    bool favorite;  /**< Whether the access point is favorite */
+    bool wps_supported;  /**< Whether WPS is supported */
+} wifi_ap_filter_s;
+
 /**
 * @}
 */
@@ -209,6 +277,54 @@ typedef enum
 */
 typedef void* wifi_ap_h;
 
+/**
+* @brief The statistics of the pool which recycles the memory of access point handles.
+*/
+typedef struct
+{
+    int pool_size;  /**< The maximum number of released handles kept for reuse */
+    int free_count;  /**< The number of released handles currently kept for reuse */
+    int in_use;  /**< The number of handles currently allocated */
+    int high_water_mark;  /**< The largest number of handles allocated at the same time */
+    unsigned int hits;  /**< The number of allocations served from the pool */
+    unsigned int misses;  /**< The number of allocations which needed new memory */
+} wifi_ap_pool_stats_s;
+
+/**
+* @brief The maximum length of ESSID in #wifi_ap_info_s
+*/
+#define WIFI_AP_INFO_ESSID_LEN 128
+
+/**
+* @brief The maximum length of BSSID in #wifi_ap_info_s
+*/
+#define WIFI_AP_INFO_BSSID_LEN 32
+
+/**
+* @brief The attributes of an access point, filled by wifi_ap_get_info()
+* @details Only the members selected in @a fields are valid.
+*/
+typedef struct
+{
+    unsigned int fields;  /**< The valid members, as a bitwise OR of #wifi_ap_field_e */
+    char essid[WIFI_AP_INFO_ESSID_LEN + 1];  /**< ESSID */
+    char bssid[WIFI_AP_INFO_BSSID_LEN + 1];  /**< BSSID */
+    int rssi;  /**< RSSI */
+    int frequency;  /**< Frequency (MHz) */
+    int max_speed;  /**< Max speed (Mbps) */
+    bool favorite;  /**< Whether the access point is favorite */
+    wifi_connection_state_e connection_state;  /**< Connection state */
+    wifi_security_type_e security_type;  /**< Security type */
+    wifi_encryption_type_e encryption_type;  /**< Encryption type */
+    bool passphrase_required;  /**< Whether passphrase is required */
+    bool wps_supported;  /**< Whether WPS is supported */
+} wifi_ap_info_s;
+
+/**
+* @brief  The handle for a scan snapshot read through wifi_scan_snapshot_open().
+*/
+typedef void* wifi_scan_snapshot_h;
+
 /**
 * @}
 */
@@ -222,6 +338,8 @@ typedef void* wifi_ap_h;
 /**
 * @brief Called when you get the found access point repeatedly.
 * @remarks  @a ap is valid only in this function. In order to use the ap outside this function, you must copy the ap with wifi_ap_clone().
+* Once the scan result is refreshed, a stale @a ap is rejected with #WIFI_ERROR_INVALID_PARAMETER.
+* The copy shares the scan result it came from, which is kept until the copy is destroyed, so wifi_ap_clone() is cheap here.
 * @param[in]  ap  The access point
 * @param[in]  user_data  The user data passed from the request function
 * @return  @c true to continue with the next iteration of the loop, \n @c false to break out of the loop
@@ -230,6 +348,19 @@ typedef void* wifi_ap_h;
 */
 typedef bool(*wifi_found_ap_cb)(wifi_ap_h ap, void* user_data);
 
+/**
+* @brief Called when you get the changed access point repeatedly.
+* @remarks  @a ap is valid only in this function. In order to use the ap outside this function, you must copy the ap with wifi_ap_clone().
+* @param[in]  ap  The access point
+* @param[in]  type  The type of change
+* @param[in]  changed_fields  The changed attributes as a bitwise OR of #wifi_ap_field_e, #WIFI_AP_FIELD_ALL for added or removed access points
+* @param[in]  user_data  The user data passed from the request function
+* @return  @c true to continue with the next iteration of the loop, \n @c false to break out of the loop
+* @pre  wifi_foreach_changed_aps() will invoke this callback.
+* @see  wifi_foreach_changed_aps()
+*/
+typedef bool(*wifi_changed_ap_cb)(wifi_ap_h ap, wifi_ap_change_type_e type, unsigned int changed_fields, void* user_data);
+
 /**
 * @brief Called when the device state is changed.
 * @param[in] error_code  The error code
@@ -272,6 +403,36 @@ typedef void(*wifi_connection_state_changed_cb)(wifi_error_e error_code, wifi_co
 */
 typedef void(*wifi_rssi_level_changed_cb)(wifi_rssi_level_e rssi_level, void* user_data);
 
+/**
+* @brief Called when a request started by wifi_connect_async(), wifi_disconnect_async() or wifi_connect_with_wps_async() is completed.
+* @remarks @a ap is valid only in this function. It is NULL if the profile of the request could not be read.
+* @param[in] request_id  The ID returned when the request was started
+* @param[in] result  The result of the request
+* @param[in] ap  The access point of the request
+* @param[in] user_data The user data passed when the request was started
+*/
+typedef void(*wifi_request_completed_cb)(int request_id, wifi_error_e result, wifi_ap_h ap, void* user_data);
+
+/**
+* @brief The latency of connection state callbacks, measured from the arrival of an event to the invocation of its callback.
+*/
+typedef struct
+{
+    unsigned int count;  /**< The number of events measured */
+    unsigned int deferred_count;  /**< The number of events whose profile had to be read from the connection manager */
+    unsigned int average_us;  /**< The average latency in microseconds */
+    unsigned int max_us;  /**< The largest latency in microseconds */
+} wifi_event_latency_stats_s;
+
+/**
+* @brief The number of connection state indications received and delivered to wifi_connection_state_changed_cb().
+*/
+typedef struct
+{
+    unsigned int received;  /**< The number of indications received */
+    unsigned int delivered;  /**< The number of indications delivered after coalescing */
+} wifi_state_event_stats_s;
+
 /**
 * @brief Initializes Wi-Fi
 * @return 0 on success, otherwise negative error value.
@@ -281,6 +442,55 @@ typedef void(*wifi_rssi_level_changed_cb)(wifi_rssi_level_e rssi_level, void* us
 */
 int wifi_initialize(void);
 
+/**
+* @brief Initializes Wi-Fi with a thread which receives Wi-Fi events.
+* @details The thread is owned by this library and runs its own main loop, so events are not delayed by a busy main loop of the application.
+* If @a callback_context is NULL, callbacks are invoked in that thread.
+* Otherwise they are invoked in @a callback_context in the order of the events.
+* @remarks @a callback_context is a GMainContext which must be iterated by the application.
+* wifi_rssi_level_changed_cb() is still invoked in the default main context of the application.
+* wifi_deinitialize() fails with #WIFI_ERROR_OPERATION_FAILED when it is called in the event thread.
+* @param[in] callback_context  The GMainContext in which callbacks are invoked, or NULL to invoke them in the event thread
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @see wifi_initialize()
+* @see wifi_deinitialize()
+*/
+int wifi_initialize_with_event_thread(void* callback_context);
+
+/**
+* @brief Initializes Wi-Fi for an event loop which is not based on GLib.
+* @details Events are received in a thread owned by this library, as with wifi_initialize_with_event_thread().
+* Callbacks are not invoked until wifi_dispatch_pending() is called.
+* @a fd becomes readable when callbacks are pending, so it can be added to poll(), epoll or any other event loop.
+* @remarks @a fd is owned by this library and is closed by wifi_deinitialize(). Don't read from it.
+* Completions of wifi_ap_commit_async() requested from a thread without a thread default GMainContext are also dispatched by wifi_dispatch_pending().
+* wifi_rssi_level_changed_cb() is not routed through @a fd. It is invoked in the default main context of the application, so it is only invoked if that context is iterated.
+* @param[out] fd  The file descriptor which becomes readable when callbacks are pending
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @see wifi_dispatch_pending()
+* @see wifi_deinitialize()
+*/
+int wifi_initialize_with_event_fd(int* fd);
+
+/**
+* @brief Invokes the pending callbacks.
+* @details Call this function when the file descriptor returned by wifi_initialize_with_event_fd() is readable.
+* Callbacks are invoked in the calling thread.
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_OPERATION  Not initialized with wifi_initialize_with_event_fd(), or called in another thread at the same time
+* @pre Wi-Fi must be initialized with wifi_initialize_with_event_fd().
+* @see wifi_initialize_with_event_fd()
+*/
+int wifi_dispatch_pending(void);
+
 /**
 * @brief Deinitializes Wi-Fi
 * @return 0 on success, otherwise negative error value.
@@ -341,6 +551,7 @@ int wifi_get_mac_address(char** mac_address);
 
 /**
 * @brief Gets the name of network interface.
+* @details The name is cached until Wi-Fi is activated or deactivated. It is found without a scan result if needed.
 * @remarks @a name must be released with free() by you.
 * @param[out] name  The name of network interface
 * @return 0 on success, otherwise negative error value.
@@ -366,6 +577,8 @@ int wifi_scan(wifi_scan_finished_cb callback, void* user_data);
 
 /**
 * @brief Gets the handle of connected access point.
+* @details The connected access point is tracked from connection events, so this function doesn't fetch the result of scan
+* unless the connection state is unknown.
 * @remarks @a handle must be released with wifi_ap_destroy().
 * @param[out] ap  The handle of access point
 * @return 0 on success, otherwise negative error value.
@@ -378,6 +591,8 @@ int wifi_get_connected_ap(wifi_ap_h* ap);
 
 /**
 * @brief Gets the result of scan.
+* @remarks This function can be called from another thread than the one running the main loop.
+* The scan result passed to @a callback stays consistent while the main loop refreshes it.
 * @param[in] callback  The callback to be called
 * @param[in] user_data The user data passed to the callback function
 * @return 0 on success, otherwise negative error value.
@@ -388,6 +603,221 @@ int wifi_get_connected_ap(wifi_ap_h* ap);
 */
 int wifi_foreach_found_aps(wifi_found_ap_cb callback, void* user_data);
 
+/**
+* @brief Gets the result of scan in the given order.
+* @details The order is computed once per scan result and shared by every caller.
+* If @a max_count is smaller than the number of found access points, only the first @a max_count
+* are selected and sorted.
+* @param[in] key  The key to order the access points
+* @param[in] max_count  The maximum number of access points to get, 0 or less to get all
+* @param[in] callback  The callback to be called
+* @param[in] user_data The user data passed to the callback function
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_found_ap_cb().
+* @see wifi_foreach_found_aps()
+*/
+int wifi_foreach_found_aps_sorted(wifi_ap_sort_key_e key, int max_count, wifi_found_ap_cb callback, void* user_data);
+
+/**
+* @brief Gets the result of scan which meets the given filter.
+* @details The filter is evaluated inside the library before @a callback is invoked,
+* so access points which don't meet it cost no callback.
+* @param[in] filter  The filter of access points
+* @param[in] callback  The callback to be called
+* @param[in] user_data The user data passed to the callback function
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_found_ap_cb().
+* @see wifi_foreach_found_aps()
+*/
+int wifi_foreach_found_aps_filtered(const wifi_ap_filter_s* filter, wifi_found_ap_cb callback, void* user_data);
+
+/**
+* @brief Copies the result of scan into an array.
+* @details Every found access point is written as one #wifi_ap_info_s with all of its attributes, in the order of wifi_foreach_found_aps().
+* @remarks If @a count is larger than @a size, only the first @a size access points are written.
+* @a buf can be NULL if @a size is 0, to get the number of found access points.
+* @param[out] buf  The array to fill
+* @param[in] size  The number of elements of @a buf
+* @param[out] count  The number of found access points
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_scan_export_alloc()
+*/
+int wifi_scan_export(wifi_ap_info_s* buf, int size, int* count);
+
+/**
+* @brief Copies the result of scan into a newly allocated array.
+* @remarks @a buf must be released with free() by you. It is NULL if there is no access point.
+* @param[out] buf  The array of found access points
+* @param[out] count  The number of elements of @a buf
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @see wifi_scan_export()
+*/
+int wifi_scan_export_alloc(wifi_ap_info_s** buf, int* count);
+
+/**
+* @brief Sets the file which keeps the result of scan between runs.
+* @details When a path is set, the scan result is stored there after scan events and loaded by wifi_initialize().
+* The loaded result is served at once as a stale result, and replaced by the live one when the main loop is idle.
+* The callback registered with wifi_set_background_scan_cb() is invoked when the live result replaces it.
+* @remarks Call this function before wifi_initialize() to serve the stored result at start-up. The cache is disabled by default.
+* Stale access points have no profile name and are disconnected. Connecting to one uses its ESSID and security type.
+* @param[in] path  The path of the cache file, or NULL to disable the cache
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_is_scan_result_stale()
+*/
+int wifi_set_scan_cache_path(const char* path);
+
+/**
+* @brief Checks whether the result of scan was loaded from the cache and not yet refreshed.
+* @param[out] stale  @c true if the result is stale, otherwise @c false
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_set_scan_cache_path()
+*/
+int wifi_is_scan_result_stale(bool* stale);
+
+/**
+* @brief Writes the result of scan to a file as a scan snapshot.
+* @details A scan snapshot is a versioned header followed by one fixed-size record per found access point, in the order of wifi_foreach_found_aps().
+* It can be read by any process through wifi_scan_snapshot_open() without parsing.
+* @remarks The snapshot is written from the beginning of @a fd, which is resized to fit it.
+* @a fd must refer to a new file or memfd which no reader has mapped yet. A reader that maps the file while it is written can see a truncated or half-written snapshot.
+* To replace a published snapshot, write it to a temporary file in the same directory and rename() that file over the old one. Readers which already mapped the old file keep reading it.
+* @param[in] fd  The file descriptor of a new regular file or memfd, opened for writing
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @see wifi_scan_snapshot_open()
+*/
+int wifi_scan_snapshot_write(int fd);
+
+/**
+* @brief Maps a scan snapshot written by wifi_scan_snapshot_write().
+* @details The snapshot is mapped, and each record is validated when it is read with wifi_scan_snapshot_get_ap_info().
+* wifi_initialize() is not required.
+* @remarks @a snapshot must be released with wifi_scan_snapshot_close(). @a fd can be closed after this function returns.
+* @param[in] fd  The file descriptor of the snapshot, opened for reading
+* @param[out] snapshot  The handle of the snapshot
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter, or @a fd does not hold a snapshot of this version
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @see wifi_scan_snapshot_close()
+*/
+int wifi_scan_snapshot_open(int fd, wifi_scan_snapshot_h* snapshot);
+
+/**
+* @brief Unmaps a scan snapshot.
+* @param[in] snapshot  The handle of the snapshot
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_scan_snapshot_open()
+*/
+int wifi_scan_snapshot_close(wifi_scan_snapshot_h snapshot);
+
+/**
+* @brief Gets the number of access points in a scan snapshot.
+* @param[in] snapshot  The handle of the snapshot
+* @param[out] count  The number of access points
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+*/
+int wifi_scan_snapshot_get_count(wifi_scan_snapshot_h snapshot, int* count);
+
+/**
+* @brief Gets an access point of a scan snapshot.
+* @details The record is validated and copied into @a info.
+* @param[in] snapshot  The handle of the snapshot
+* @param[in] index  The index of the access point, from 0 to the count - 1
+* @param[out] info  The attributes of the access point
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OPERATION_FAILED  The record is corrupt
+*/
+int wifi_scan_snapshot_get_ap_info(wifi_scan_snapshot_h snapshot, int index, wifi_ap_info_s* info);
+
+/**
+* @brief Gets the access points which are added, removed or changed by the latest scan.
+* @details Access points are matched by profile name between the two most recent scan results.
+* Unchanged access points are not reported.
+* The changes are computed when the result of a scan is read, and are reported by every call until the result of the next scan is read.
+* Connection events between two scans don't replace them.
+* @remarks The handles passed to the callback are valid only in the callback.
+* @param[in] callback  The callback to be called
+* @param[in] user_data The user data passed to the callback function
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_changed_ap_cb().
+* @see wifi_foreach_found_aps()
+*/
+int wifi_foreach_changed_aps(wifi_changed_ap_cb callback, void* user_data);
+
+/**
+* @brief Gets the handle of the found access point which has the given BSSID.
+* @details The lookup uses an index built once per scan result, without walking the list.
+* @remarks @a ap must be released with wifi_ap_destroy().
+* @param[in] bssid  The BSSID(Basic Service Set Identifier), such as "00:11:22:33:44:55"
+* @param[out] ap  The handle of access point
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_AP_NOT_FOUND  There is no matching AP
+*/
+int wifi_get_ap_by_bssid(const char* bssid, wifi_ap_h* ap);
+
+/**
+* @brief Gets the handles of the found access points which have the given ESSID.
+* @details Several access points can share one ESSID, all of them are returned in the order of wifi_foreach_found_aps().
+* The lookup uses an index built once per scan result, without walking the list.
+* @remarks Each handle of @a aps must be released with wifi_ap_destroy(), and @a aps itself with free().
+* @param[in] essid  The ESSID(Extended Service Set Identifier)
+* @param[out] aps  The array of handles of access points
+* @param[out] count  The number of elements of @a aps
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_AP_NOT_FOUND  There is no matching AP
+*/
+int wifi_get_ap_by_essid(const char* essid, wifi_ap_h** aps, int* count);
+
+/**
+* @brief Gets the handle of the found access point which has the given profile name.
+* @details The lookup uses an index built once per scan result, without walking the list.
+* @remarks @a ap must be released with wifi_ap_destroy().
+* @param[in] profile_name  The profile name of access point
+* @param[out] ap  The handle of access point
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_AP_NOT_FOUND  There is no matching AP
+*/
+int wifi_get_ap_by_profile_name(const char* profile_name, wifi_ap_h* ap);
+
 /**
 * @brief Connects the access point, asynchronously.
 * @param[in] ap  The handle of access point
@@ -426,6 +856,111 @@ int wifi_disconnect(wifi_ap_h ap);
 */
 int wifi_connect_with_wps(wifi_ap_h ap, wifi_wps_type_e type, const char* pin);
 
+/**
+* @brief Connects the access point and reports the result of this request only.
+* @details Several requests can be in flight. Each response is matched to its request by profile name and type,
+* and wifi_connection_state_changed_cb() is still invoked.
+* @remarks Requests which are pending when wifi_deinitialize() is called fail with #WIFI_ERROR_OPERATION_FAILED.
+* @param[in] ap  The handle of access point
+* @param[in] callback  The callback to be called when the request is completed
+* @param[in] user_data The user data passed to the callback function
+* @param[out] request_id  The ID of the request, passed to @a callback. It can be NULL.
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_request_completed_cb().
+* @see wifi_connect()
+*/
+int wifi_connect_async(wifi_ap_h ap, wifi_request_completed_cb callback, void* user_data, int* request_id);
+
+/**
+* @brief Disconnects the access point and reports the result of this request only.
+* @details See wifi_connect_async() for how requests are matched.
+* @param[in] ap  The handle of access point
+* @param[in] callback  The callback to be called when the request is completed
+* @param[in] user_data The user data passed to the callback function
+* @param[out] request_id  The ID of the request, passed to @a callback. It can be NULL.
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_request_completed_cb().
+* @see wifi_disconnect()
+*/
+int wifi_disconnect_async(wifi_ap_h ap, wifi_request_completed_cb callback, void* user_data, int* request_id);
+
+/**
+* @brief Connects the access point with WPS and reports the result of this request only.
+* @details See wifi_connect_async() for how requests are matched.
+* @param[in] ap  The handle of access point
+* @param[in] type  The type of WPS
+* @param[in] pin  The pin value, which is valid only when type is WIFI_WPS_TYPE_PIN.
+* @param[in] callback  The callback to be called when the request is completed
+* @param[in] user_data The user data passed to the callback function
+* @param[out] request_id  The ID of the request, passed to @a callback. It can be NULL.
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post This function invokes wifi_request_completed_cb().
+* @see wifi_connect_with_wps()
+*/
+int wifi_connect_with_wps_async(wifi_ap_h ap, wifi_wps_type_e type, const char* pin,
+		wifi_request_completed_cb callback, void* user_data, int* request_id);
+
+/**
+* @brief Gets the latency of connection state events.
+* @details The profile of an event is taken from the connected access point or the last found access points.
+* If it is not known there, it is read from the connection manager in a separate thread,
+* and the callbacks of later events wait for it so that they are invoked in order.
+* @param[out] stats  The latency statistics
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_reset_event_latency_stats()
+* @see wifi_set_connection_state_changed_cb()
+*/
+int wifi_get_event_latency_stats(wifi_event_latency_stats_s* stats);
+
+/**
+* @brief Resets the latency statistics of connection state events.
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @see wifi_get_event_latency_stats()
+*/
+int wifi_reset_event_latency_stats(void);
+
+/**
+* @brief Sets the window in which connection state indications of the same access point are coalesced.
+* @details Association and configuration indications which arrive within @a window_ms of the first one
+* are delivered to wifi_connection_state_changed_cb() once, with the latest state of the access point.
+* An indication waiting in the window is delivered before any connection or disconnection of the same access point.
+* @remarks Coalescing is disabled by default.
+* @param[in] window_ms  The window in milliseconds, 0 to deliver every indication
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_get_state_event_stats()
+*/
+int wifi_set_state_event_coalescing(int window_ms);
+
+/**
+* @brief Gets the number of connection state indications received and delivered.
+* @param[out] stats  The statistics of connection state indications
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_set_state_event_coalescing()
+*/
+int wifi_get_state_event_stats(wifi_state_event_stats_s* stats);
+
 /**
 * @brief Deletes the information of stored access point.
 * @details If an AP is connected, then connection information will be stored.
@@ -551,6 +1086,8 @@ int wifi_ap_destroy(wifi_ap_h ap);
 /**
 * @brief Clons the handle of access point.
 * @remarks @a cloned_ap must be released with wifi_ap_destroy().
+* If @a origin comes from the scan result, @a cloned_ap shares it instead of copying and keeps it alive after refreshes.
+* A shared access point is copied the first time it is modified.
 * @param[out] cloned_ap  The handle of cloned access point
 * @param[in] origin  The handle of origin access point
 * @return 0 on success, otherwise negative error value.
@@ -561,6 +1098,41 @@ int wifi_ap_destroy(wifi_ap_h ap);
 */
 int wifi_ap_clone(wifi_ap_h* cloned_ap, wifi_ap_h origin);
 
+/**
+* @brief Sets the size of the pool which recycles the memory of access point handles.
+* @details The memory of handles released with wifi_ap_destroy() is kept for reuse
+* by wifi_ap_create(), wifi_ap_clone() and the first modification of a found access point, up to @a size handles.
+* @param[in] size  The maximum number of released handles to keep, 0 disables the pool
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_ap_pool_get_stats()
+*/
+int wifi_ap_pool_set_size(int size);
+
+/**
+* @brief Gets the statistics of the pool which recycles the memory of access point handles.
+* @param[out] stats  The statistics of the pool
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_ap_pool_set_size()
+*/
+int wifi_ap_pool_get_stats(wifi_ap_pool_stats_s* stats);
+
+/**
+* @brief Gets several attributes of access point at once.
+* @details The handle is validated once and nothing is allocated, so this is cheaper than calling the getter of each attribute.
+* @remarks An attribute that can't be converted, such as an unknown security type, is left out of @a info->fields.
+* @param[in] ap  The handle of access point
+* @param[out] info  The attributes of access point
+* @param[in] field_mask  The attributes to get, as a bitwise OR of #wifi_ap_field_e
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+*/
+int wifi_ap_get_info(wifi_ap_h ap, wifi_ap_info_s* info, unsigned int field_mask);
+
 /**
 * @}
 */
@@ -571,6 +1143,61 @@ int wifi_ap_clone(wifi_ap_h* cloned_ap, wifi_ap_h origin);
 * @{
 */
 
+/**
+* @brief Called when the changes queued by wifi_ap_commit_async() are applied.
+* @param[in] result  The result of the modification
+* @param[in] user_data The user data passed from wifi_ap_commit_async()
+* @see wifi_ap_commit_async()
+*/
+typedef void(*wifi_ap_committed_cb)(wifi_error_e result, void* user_data);
+
+/**
+* @brief Starts a batch of changes to the network configuration of access point.
+* @details Until wifi_ap_commit() is called, wifi_ap_set_ip_config_type(), wifi_ap_set_ip_address(), wifi_ap_set_subnet_mask(),
+* wifi_ap_set_gateway_address(), wifi_ap_set_proxy_address(), wifi_ap_set_proxy_type(), wifi_ap_set_dns_address() and wifi_ap_set_passphrase()
+* only change @a ap, and are applied together by wifi_ap_commit().
+* @param[in] ap  The handle of access point
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation, a batch is already started
+* @see wifi_ap_commit()
+*/
+int wifi_ap_begin_edit(wifi_ap_h ap);
+
+/**
+* @brief Applies the changes made since wifi_ap_begin_edit() with one request.
+* @details Nothing is sent if no setter was called.
+* @param[in] ap  The handle of access point
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation, no batch is started
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @see wifi_ap_begin_edit()
+*/
+int wifi_ap_commit(wifi_ap_h ap);
+
+/**
+* @brief Applies the changes made since wifi_ap_begin_edit() without waiting for the result.
+* @details The changes are copied and sent from another thread. Queued changes are sent in the order they were committed,
+* also across access points. To change one attribute without blocking, call wifi_ap_begin_edit(), the setter and this function.
+* @remarks @a callback is invoked in the thread-default main context of the caller, even if nothing was changed.
+* wifi_deinitialize() waits until queued changes are sent.
+* @param[in] ap  The handle of access point
+* @param[in] callback  The callback to be called when the changes are applied, or NULL
+* @param[in] user_data The user data passed to the callback function
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation, no batch is started
+* @retval #WIFI_ERROR_OUT_OF_MEMORY  Out of memory
+* @retval #WIFI_ERROR_OPERATION_FAILED  Operation failed
+* @post wifi_ap_committed_cb() will be invoked.
+* @see wifi_ap_begin_edit()
+*/
+int wifi_ap_commit_async(wifi_ap_h ap, wifi_ap_committed_cb callback, void* user_data);
+
 /**
 * @brief Gets ESSID(Extended Service Set Identifier).
 * @remarks @a essid must be released with free() by you.
@@ -583,6 +1210,19 @@ int wifi_ap_clone(wifi_ap_h* cloned_ap, wifi_ap_h origin);
 */
 int wifi_ap_get_essid(wifi_ap_h ap, char** essid);
 
+/**
+* @brief Gets ESSID(Extended Service Set Identifier) without copying it.
+* @remarks @a essid is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[out] essid  The ESSID
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_ap_get_essid()
+*/
+int wifi_ap_get_essid_ref(wifi_ap_h ap, const char** essid);
+
 /**
 * @brief Gets BSSID(Basic Service Set Identifier).
 * @remarks @a bssid must be released with free() by you.
@@ -595,6 +1235,19 @@ int wifi_ap_get_essid(wifi_ap_h ap, char** essid);
 */
 int wifi_ap_get_bssid(wifi_ap_h ap, char** bssid);
 
+/**
+* @brief Gets BSSID(Basic Service Set Identifier) without copying it.
+* @remarks @a bssid is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[out] bssid  The BSSID
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @see wifi_ap_get_bssid()
+*/
+int wifi_ap_get_bssid_ref(wifi_ap_h ap, const char** bssid);
+
 /**
 * @brief Gets the RSSI.
 * @param[in] ap  The handle of access point
@@ -771,6 +1424,21 @@ int wifi_ap_set_gateway_address(wifi_ap_h ap, wifi_address_family_e address_fami
 */
 int wifi_ap_get_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family, char** proxy_address);
 
+/**
+* @brief Gets the proxy address without copying it.
+* @remarks @a proxy_address is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[in] address_family  The address family
+* @param[out] proxy_address  The proxy address
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED  Address family not supported
+* @see wifi_ap_get_proxy_address()
+*/
+int wifi_ap_get_proxy_address_ref(wifi_ap_h ap, wifi_address_family_e address_family, const char** proxy_address);
+
 /**
 * @brief Sets the proxy address.
 * @param[in] ap  The handle of access point
@@ -958,6 +1626,20 @@ int wifi_ap_set_eap_passphrase(wifi_ap_h ap, const char* user_name, const char*
 */
 int wifi_ap_get_eap_ca_cert_file(wifi_ap_h ap, char** file);
 
+/**
+* @brief Gets the CA Certificate of EAP without copying it.
+* @remarks @a file is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[out] file  The file path of CA Certificate
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @see wifi_ap_get_eap_ca_cert_file()
+*/
+int wifi_ap_get_eap_ca_cert_file_ref(wifi_ap_h ap, const char** file);
+
 /**
 * @brief Sets the CA Certificate of EAP.
 * @param[in] ap  The handle of access point
@@ -982,6 +1664,20 @@ int wifi_ap_set_eap_ca_cert_file(wifi_ap_h ap, const char* file);
 */
 int wifi_ap_get_eap_client_cert_file(wifi_ap_h ap, char** file);
 
+/**
+* @brief Gets the Client Certificate of EAP without copying it.
+* @remarks @a file is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[out] file  The file path of Client Certificate
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @see wifi_ap_get_eap_client_cert_file()
+*/
+int wifi_ap_get_eap_client_cert_file_ref(wifi_ap_h ap, const char** file);
+
 /**
 * @brief Sets the CA Certificate of EAP.
 * @param[in] ap  The handle of access point
@@ -1006,6 +1702,20 @@ int wifi_ap_set_eap_client_cert_file(wifi_ap_h ap, const char* file);
 */
 int wifi_ap_get_eap_private_key_file(wifi_ap_h ap, char** file);
 
+/**
+* @brief Gets the private key file of EAP without copying it.
+* @remarks @a file is owned by @a ap and must not be released. It is valid until @a ap is destroyed or modified
+* or, for an access point passed to wifi_found_ap_cb(), until the scan result is refreshed.
+* @param[in] ap  The handle of access point
+* @param[out] file  The file path of private key
+* @return 0 on success, otherwise negative error value.
+* @retval #WIFI_ERROR_NONE  Successful
+* @retval #WIFI_ERROR_INVALID_PARAMETER  Invalid parameter
+* @retval #WIFI_ERROR_INVALID_OPERATION  Invalid operation
+* @see wifi_ap_get_eap_private_key_file()
+*/
+int wifi_ap_get_eap_private_key_file_ref(wifi_ap_h ap, const char** file);
+
 /**
 * @brief Sets the private key information of EAP.
 * @param[in] ap  The handle of access point
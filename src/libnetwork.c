@@ -17,54 +17,1569 @@
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include <glib.h>
 #include "net_wifi_private.h"
 
-static GSList *ap_handle_list = NULL;
+#define WIFI_AP_SLOT_BITS 16
+#define WIFI_AP_SLOT_MAX (1 << WIFI_AP_SLOT_BITS)
+#define WIFI_AP_SLOT_MASK (WIFI_AP_SLOT_MAX - 1)
+#define WIFI_AP_SLOT_CHUNK 256
+#define WIFI_AP_POOL_DEFAULT_SIZE 32
+#define WIFI_AP_SORT_KEY_NUM (WIFI_AP_SORT_KEY_ESSID + 1)
+#define WIFI_CONNECTED_AP_UNKNOWN 0
+#define WIFI_CONNECTED_AP_NONE 1
+#define WIFI_CONNECTED_AP_KNOWN 2
+
+/* An immutable profile array fetched by one refresh. The scan result and
+ * every AP handle pointing into it hold a reference, so retaining an AP
+ * doesn't copy it and the array outlives the refresh that replaced it. */
+struct _profile_snapshot_s {
+	volatile gint ref_count;
+	int count;
+	net_profile_info_t *profiles;
+};
+
+/* A wifi_ap_h encodes (generation << WIFI_AP_SLOT_BITS | slot index).
+ * Releasing a slot bumps its generation, so a stale handle fails validation
+ * with one bounds check and one compare instead of touching freed memory.
+ * ap_info is either owned by the slot or shared through snapshot.
+ * Between wifi_ap_begin_edit() and wifi_ap_commit(), setters only set dirty. */
+struct _ap_slot_s {
+	guint generation;
+	int next_free;
+	bool owned;
+	bool editing;
+	bool dirty;
+	struct _profile_snapshot_s *snapshot;
+	net_profile_info_t *ap_info;
+};
+
+/* Slots are allocated, released and looked up under the ap_table lock.
+ * Chunks never move once allocated. */
+struct _ap_slot_table_s {
+	struct _ap_slot_s *chunks[WIFI_AP_SLOT_MAX / WIFI_AP_SLOT_CHUNK];
+	volatile gint count;
+	int free_head;
+};
+
+/* Freed net_profile_info_t blocks are chained through their first bytes */
+struct _ap_pool_block_s {
+	struct _ap_pool_block_s *next;
+};
+
+struct _ap_pool_s {
+	struct _ap_pool_block_s *free_list;
+	int free_count;
+	int max_size;
+	int in_use;
+	int high_water_mark;
+	unsigned int hits;
+	unsigned int misses;
+};
+
+struct _wifi_cb_s {
+	wifi_device_state_changed_cb device_state_cb;
+	void *device_state_user_data;
+	wifi_scan_finished_cb bg_scan_cb;
+	void *bg_scan_user_data;
+	wifi_scan_finished_cb scan_request_cb;
+	void *scan_request_user_data;
+	wifi_connection_state_changed_cb connection_state_cb;
+	void *connection_state_user_data;
+};
+
+#define WIFI_AP_SUMMARY_FAVORITE 0x01
+#define WIFI_AP_SUMMARY_WPS_SUPPORTED 0x02
+#define WIFI_AP_SUMMARY_BSSID_VALID 0x04
+
+/* Parallel arrays of the attributes used to rank and filter APs, so hot loops
+ * don't stride through whole net_profile_info_t entries. One allocation. */
+struct _profile_summary_s {
+	guint64 *bssid;
+	guint32 *frequency;
+	guint32 *max_rate;
+	guint8 *rssi;
+	gint8 *security_type;
+	guint8 *flags;
+};
+
+/* The indexes map to (position + 1) in profiles and are built on first lookup */
+struct _profile_index_s {
+	GHashTable *bssid_index;
+	GHashTable *essid_index;
+	GHashTable *name_index;
+};
+
+/* Positions sorted by one key. Only the first count entries are ordered
+ * when a top-K request was served by partial selection. A published order
+ * is never changed, a longer one replaces it and is chained through next. */
+struct _profile_order_s {
+	int *positions;
+	int count;
+	struct _profile_order_s *next;
+};
+
+struct _profile_change_s {
+	int index;
+	wifi_ap_change_type_e type;
+	unsigned int changed_fields;
+};
+
+/* Changes between two consecutive scan results. It is computed when a scan
+ * result is fetched and shared by every list published until the next one.
+ * Removed APs index prev, the others index next. */
+struct _profile_diff_s {
+	volatile gint ref_count;
+	struct _profile_snapshot_s *prev;
+	struct _profile_snapshot_s *next;
+	int count;
+	struct _profile_change_s *changes;
+};
+
+/* One published scan result. It is complete before it is published and
+ * immutable afterwards, except for the index and the sort orders which
+ * readers build on first use and install with a compare-and-swap.
+ * count and profiles mirror the snapshot. */
+struct _profile_list_s {
+	int count;
+	net_profile_info_t *profiles;
+	struct _profile_snapshot_s *snapshot;
+	wifi_ap_h *handles;
+	guint version;
+	struct _profile_summary_s summary;
+	struct _profile_diff_s *diff;
+	struct _profile_index_s *index;
+	struct _profile_order_s *orders[WIFI_AP_SORT_KEY_NUM];
+	struct _profile_order_s *retired_orders;
+};
+
+struct _profile_sort_s {
+	struct _profile_list_s *profile_list;
+	wifi_ap_sort_key_e key;
+};
+
+/* Readers count themselves in the current epoch while they use a list.
+ * A replaced list waits in pending until the epoch flips, then in draining
+ * until no reader is left in the previous epoch. Only the refreshing
+ * thread flips epochs and frees lists, so readers never wait. */
+struct _profile_epoch_s {
+	volatile gint current;
+	volatile gint readers[2];
+	GSList *pending;
+	GSList *draining;
+};
+
+/* The connected AP as last told by an event or a refresh, so finding it
+ * needs no IPC. Events win over a refresh whose fetch they overlapped,
+ * which event_count detects. Protected by the ap_table lock. */
+struct _connected_ap_s {
+	int state;
+	guint event_count;
+	struct _profile_snapshot_s *snapshot;
+	net_profile_info_t *ap_info;
+};
+
+/* A profile modification run by the request thread. ap_info is copied at
+ * commit time, and the callback runs in the context of the committing thread. */
+struct _profile_request_s {
+	net_profile_info_t ap_info;
+	bool send;
+	int result;
+	wifi_ap_committed_cb callback;
+	void *user_data;
+	GMainContext *context;
+};
+
+/* A connect, disconnect or WPS request waiting for its response event.
+ * profile_name is empty when the request connects with the Wi-Fi info,
+ * then the response is matched by essid. */
+struct _connection_request_s {
+	int id;
+	net_event_t event;
+	char profile_name[NET_PROFILE_NAME_LEN_MAX+1];
+	char essid[NET_WLAN_ESSID_LEN+1];
+	wifi_request_completed_cb callback;
+	void *user_data;
+};
+
+/* The callbacks of one connection event. profile_info is resolved without
+ * IPC when possible, otherwise fetched in the event thread. */
+struct _connection_event_s {
+	net_event_t event;
+	char profile_name[NET_PROFILE_NAME_LEN_MAX+1];
+	wifi_error_e error;
+	wifi_connection_state_e state;
+	net_state_type_t profile_state;
+	bool is_requested;
+	bool fetch;
+	bool has_profile;
+	net_profile_info_t profile_info;
+	gint64 time;
+	GMainContext *context;
+};
+
+/* State indications of one profile waiting for the coalescing window to close */
+struct _state_event_s {
+	char profile_name[NET_PROFILE_NAME_LEN_MAX+1];
+	net_state_type_t state;
+	bool is_requested;
+	gint64 time;
+	guint serial;
+	GSource *timer;
+};
+
+/* Owns the main loop in which events are received when the application asks
+ * for it. Callbacks run there too, unless callback_context is set. */
+struct _event_thread_s {
+	GThread *thread;
+	GMainContext *context;
+	GMainLoop *loop;
+	GMainContext *callback_context;
+};
+
+struct _marshalled_event_s {
+	net_event_info_t info;
+	gint64 time;
+	guint generation;
+};
+
+struct _event_latency_s {
+	unsigned int count;
+	unsigned int deferred;
+	guint64 total_us;
+	guint64 max_us;
+};
+
+static struct _wifi_cb_s wifi_callbacks = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+static struct _profile_list_s *current_profile_list = NULL;
+static volatile gint profile_list_is_valid = FALSE;
+static guint profile_list_version = 0;
+static volatile gint profile_list_is_stale = FALSE;
+static struct _profile_epoch_s profile_epoch = {0, {0, 0}, NULL, NULL};
+static struct _ap_slot_table_s ap_slots = {{NULL}, 0, -1};
+static struct _ap_pool_s ap_pool = {NULL, 0, WIFI_AP_POOL_DEFAULT_SIZE, 0, 0, 0, 0};
+static struct _connected_ap_s connected_ap = {WIFI_CONNECTED_AP_UNKNOWN, 0, NULL, NULL};
+static char *scan_cache_path = NULL;
+static char *cached_intf_name = NULL;
+static GThreadPool *profile_request_pool = NULL;
+static GThreadPool *scan_cache_pool = NULL;
+static GQueue connection_requests = {NULL, NULL, 0};
+static volatile gint last_request_id = 0;
+static GThreadPool *connection_event_pool = NULL;
+static volatile gint connection_events_queued = 0;
+static struct _event_latency_s event_latency = {0, 0, 0, 0};
+static GHashTable *pending_state_events = NULL;
+static struct _event_thread_s event_thread = {NULL, NULL, NULL, NULL};
+static volatile gint event_thread_generation = 0;
+static guint state_event_serial = 0;
+static int event_fd = -1;
+static volatile gint state_event_window = 0;
+static wifi_state_event_stats_s state_event_stats = {0, 0};
+static volatile gint scan_cache_dirty = FALSE;
+static volatile gint profile_list_scanned = FALSE;
+static struct _profile_snapshot_s *last_scan_snapshot = NULL;
+static GSource *scan_cache_refresh_source = NULL;
+
+G_LOCK_DEFINE_STATIC(profile_refresh);
+G_LOCK_DEFINE_STATIC(ap_table);
+G_LOCK_DEFINE_STATIC(scan_cache);
+G_LOCK_DEFINE_STATIC(intf_name);
+G_LOCK_DEFINE_STATIC(profile_request);
+G_LOCK_DEFINE_STATIC(connection_request);
+G_LOCK_DEFINE_STATIC(connection_event);
+G_LOCK_DEFINE_STATIC(event_latency);
+G_LOCK_DEFINE_STATIC(state_event);
+
+/* The pool and slot helpers below expect the ap_table lock to be held */
+static void __libnet_shrink_ap_pool(int size)
+{
+	while (ap_pool.free_count > size) {
+		struct _ap_pool_block_s *block = ap_pool.free_list;
+
+		ap_pool.free_list = block->next;
+		ap_pool.free_count--;
+		g_free(block);
+	}
+}
+
+static net_profile_info_t *__libnet_get_pooled_ap_info(void)
+{
+	net_profile_info_t *ap_info;
+
+	if (ap_pool.free_list) {
+		ap_info = (net_profile_info_t *)ap_pool.free_list;
+		ap_pool.free_list = ap_pool.free_list->next;
+		ap_pool.free_count--;
+		ap_pool.hits++;
+		memset(ap_info, 0, sizeof(net_profile_info_t));
+	} else {
+		ap_info = g_try_malloc0(sizeof(net_profile_info_t));
+		if (ap_info == NULL)
+			return NULL;
+
+		ap_pool.misses++;
+	}
+
+	ap_pool.in_use++;
+	if (ap_pool.in_use > ap_pool.high_water_mark)
+		ap_pool.high_water_mark = ap_pool.in_use;
+
+	return ap_info;
+}
+
+static void __libnet_put_pooled_ap_info(net_profile_info_t *ap_info)
+{
+	struct _ap_pool_block_s *block = (struct _ap_pool_block_s *)ap_info;
+
+	if (ap_info == NULL)
+		return;
+
+	ap_pool.in_use--;
+
+	if (ap_pool.free_count >= ap_pool.max_size) {
+		g_free(ap_info);
+		return;
+	}
+
+	block->next = ap_pool.free_list;
+	ap_pool.free_list = block;
+	ap_pool.free_count++;
+}
+
+static struct _profile_snapshot_s *__libnet_ref_profile_snapshot(struct _profile_snapshot_s *snapshot)
+{
+	g_atomic_int_inc(&snapshot->ref_count);
+	return snapshot;
+}
+
+static void __libnet_unref_profile_snapshot(struct _profile_snapshot_s *snapshot)
+{
+	if (g_atomic_int_dec_and_test(&snapshot->ref_count) == FALSE)
+		return;
+
+	if (snapshot->count > 0)
+		g_free(snapshot->profiles);
+
+	g_free(snapshot);
+}
+
+static void __libnet_unref_profile_diff(struct _profile_diff_s *diff)
+{
+	if (g_atomic_int_dec_and_test(&diff->ref_count) == FALSE)
+		return;
+
+	__libnet_unref_profile_snapshot(diff->prev);
+	__libnet_unref_profile_snapshot(diff->next);
+	g_free(diff->changes);
+	g_free(diff);
+}
+
+static struct _ap_slot_s *__libnet_get_ap_slot(int index)
+{
+	return &ap_slots.chunks[index / WIFI_AP_SLOT_CHUNK][index % WIFI_AP_SLOT_CHUNK];
+}
+
+static struct _ap_slot_s *__libnet_lookup_ap_slot(wifi_ap_h ap_h)
+{
+	guint value = GPOINTER_TO_UINT(ap_h);
+	int index = value & WIFI_AP_SLOT_MASK;
+	struct _ap_slot_s *slot;
+
+	if (index >= g_atomic_int_get(&ap_slots.count))
+		return NULL;
+
+	slot = __libnet_get_ap_slot(index);
+	if (slot->ap_info == NULL || slot->generation != (value >> WIFI_AP_SLOT_BITS))
+		return NULL;
+
+	return slot;
+}
+
+static wifi_ap_h __libnet_alloc_ap_slot(net_profile_info_t *ap_info, bool owned,
+		struct _profile_snapshot_s *snapshot)
+{
+	struct _ap_slot_s *slot;
+	int index;
+
+	if (ap_slots.free_head >= 0) {
+		index = ap_slots.free_head;
+		slot = __libnet_get_ap_slot(index);
+		ap_slots.free_head = slot->next_free;
+	} else {
+		if (ap_slots.count >= WIFI_AP_SLOT_MAX) {
+			WIFI_LOG(WIFI_ERROR, "Error!! AP handle table is full\n");
+			return NULL;
+		}
+
+		index = ap_slots.count;
+		if (ap_slots.chunks[index / WIFI_AP_SLOT_CHUNK] == NULL) {
+			ap_slots.chunks[index / WIFI_AP_SLOT_CHUNK] =
+					g_try_new0(struct _ap_slot_s, WIFI_AP_SLOT_CHUNK);
+			if (ap_slots.chunks[index / WIFI_AP_SLOT_CHUNK] == NULL)
+				return NULL;
+		}
+
+		g_atomic_int_inc(&ap_slots.count);
+		slot = __libnet_get_ap_slot(index);
+		slot->generation = 1;
+	}
+
+	slot->next_free = -1;
+	slot->owned = owned;
+	slot->editing = false;
+	slot->dirty = false;
+	slot->snapshot = snapshot ? __libnet_ref_profile_snapshot(snapshot) : NULL;
+	slot->ap_info = ap_info;
+
+	return GUINT_TO_POINTER((slot->generation << WIFI_AP_SLOT_BITS) | index);
+}
+
+static void __libnet_release_ap_slot(wifi_ap_h ap_h)
+{
+	struct _ap_slot_s *slot = __libnet_lookup_ap_slot(ap_h);
+
+	if (slot == NULL)
+		return;
+
+	if (slot->owned)
+		__libnet_put_pooled_ap_info(slot->ap_info);
+	if (slot->snapshot)
+		__libnet_unref_profile_snapshot(slot->snapshot);
+
+	slot->ap_info = NULL;
+	slot->owned = false;
+	slot->editing = false;
+	slot->dirty = false;
+	slot->snapshot = NULL;
+	slot->generation = (slot->generation + 1) & WIFI_AP_SLOT_MASK;
+	if (slot->generation == 0)
+		slot->generation = 1;
+
+	slot->next_free = ap_slots.free_head;
+	ap_slots.free_head = GPOINTER_TO_UINT(ap_h) & WIFI_AP_SLOT_MASK;
+}
+
+/* Chunks and generations are kept, so a handle which survives
+ * wifi_deinitialize() can't alias an AP after the next wifi_initialize() */
+static void __libnet_clear_ap_slots(void)
+{
+	int i;
+
+	ap_slots.free_head = -1;
+
+	for (i = ap_slots.count - 1; i >= 0; i--) {
+		struct _ap_slot_s *slot = __libnet_get_ap_slot(i);
+
+		if (slot->ap_info) {
+			if (slot->owned)
+				__libnet_put_pooled_ap_info(slot->ap_info);
+			if (slot->snapshot)
+				__libnet_unref_profile_snapshot(slot->snapshot);
+
+			slot->ap_info = NULL;
+			slot->owned = false;
+			slot->editing = false;
+			slot->dirty = false;
+			slot->snapshot = NULL;
+			slot->generation = (slot->generation + 1) & WIFI_AP_SLOT_MASK;
+			if (slot->generation == 0)
+				slot->generation = 1;
+		}
+
+		slot->next_free = ap_slots.free_head;
+		ap_slots.free_head = i;
+	}
+}
+
+/* Accepts exactly "xx:xx:xx:xx:xx:xx" with hexadecimal digits */
+static bool __libnet_parse_bssid(const char *bssid, guint64 *value)
+{
+	int i;
+
+	for (i = 0; i < 17; i++) {
+		if (i % 3 == 2) {
+			if (bssid[i] != ':')
+				return false;
+		} else if (isxdigit((unsigned char)bssid[i]) == 0) {
+			return false;
+		}
+	}
+
+	if (bssid[17] != '\0')
+		return false;
+
+	*value = 0;
+	for (i = 0; i < 17; i += 3)
+		*value = (*value << 8) | (g_ascii_xdigit_value(bssid[i]) << 4) |
+				g_ascii_xdigit_value(bssid[i + 1]);
+
+	return true;
+}
+
+static int __libnet_get_security_type(wlan_security_mode_type_t sec_mode)
+{
+	switch (sec_mode) {
+	case WLAN_SEC_MODE_NONE:
+		return WIFI_SECURITY_TYPE_NONE;
+	case WLAN_SEC_MODE_WEP:
+		return WIFI_SECURITY_TYPE_WEP;
+	case WLAN_SEC_MODE_IEEE8021X:
+		return WIFI_SECURITY_TYPE_EAP;
+	case WLAN_SEC_MODE_WPA_PSK:
+		return WIFI_SECURITY_TYPE_WPA_PSK;
+	case WLAN_SEC_MODE_WPA2_PSK:
+		return WIFI_SECURITY_TYPE_WPA2_PSK;
+	default:
+		return -1;
+	}
+}
+
+static void __libnet_clear_profile_summary(struct _profile_summary_s *summary)
+{
+	g_free(summary->bssid);
+	memset(summary, 0, sizeof(struct _profile_summary_s));
+}
+
+static bool __libnet_build_profile_summary(struct _profile_list_s *profile_list)
+{
+	struct _profile_summary_s *summary = &profile_list->summary;
+	net_profile_info_t *profile_info;
+	int count = profile_list->count;
+	int i;
+
+	if (count == 0)
+		return true;
+
+	summary->bssid = g_try_malloc0(count * (sizeof(guint64) + 2 * sizeof(guint32) + 3));
+	if (summary->bssid == NULL)
+		return false;
+
+	summary->frequency = (guint32 *)(summary->bssid + count);
+	summary->max_rate = summary->frequency + count;
+	summary->rssi = (guint8 *)(summary->max_rate + count);
+	summary->security_type = (gint8 *)(summary->rssi + count);
+	summary->flags = (guint8 *)(summary->security_type + count);
+
+	for (i = 0; i < count; i++) {
+		profile_info = &profile_list->profiles[i];
+
+		summary->frequency[i] = profile_info->ProfileInfo.Wlan.frequency;
+		summary->max_rate[i] = profile_info->ProfileInfo.Wlan.max_rate;
+		summary->rssi[i] = profile_info->ProfileInfo.Wlan.Strength;
+		summary->security_type[i] = __libnet_get_security_type(
+				profile_info->ProfileInfo.Wlan.security_info.sec_mode);
+
+		if (profile_info->Favourite)
+			summary->flags[i] |= WIFI_AP_SUMMARY_FAVORITE;
+		if (profile_info->ProfileInfo.Wlan.security_info.wps_support)
+			summary->flags[i] |= WIFI_AP_SUMMARY_WPS_SUPPORTED;
+		if (__libnet_parse_bssid(profile_info->ProfileInfo.Wlan.bssid, &summary->bssid[i]))
+			summary->flags[i] |= WIFI_AP_SUMMARY_BSSID_VALID;
+	}
+
+	return true;
+}
+
+static void __libnet_free_essid_matches(gpointer data)
+{
+	g_slist_free(data);
+}
+
+static void __libnet_free_profile_index(struct _profile_index_s *index)
+{
+	if (index == NULL)
+		return;
+
+	g_hash_table_destroy(index->name_index);
+	g_hash_table_destroy(index->essid_index);
+	g_hash_table_destroy(index->bssid_index);
+	g_free(index);
+}
+
+static struct _profile_index_s *__libnet_get_profile_index(struct _profile_list_s *profile_list)
+{
+	struct _profile_index_s *index = g_atomic_pointer_get(&profile_list->index);
+	net_profile_info_t *profile_info;
+	gpointer position;
+	GSList *matches;
+	int i;
+
+	if (index)
+		return index;
+
+	index = g_try_new0(struct _profile_index_s, 1);
+	if (index == NULL)
+		return NULL;
+
+	index->name_index = g_hash_table_new(g_str_hash, g_str_equal);
+	index->bssid_index = g_hash_table_new(g_int64_hash, g_int64_equal);
+	index->essid_index = g_hash_table_new_full(g_str_hash, g_str_equal,
+			NULL, __libnet_free_essid_matches);
+
+	/* Walk backwards so that the ESSID matches keep the order of the list */
+	for (i = profile_list->count - 1; i >= 0; i--) {
+		profile_info = &profile_list->profiles[i];
+		position = GINT_TO_POINTER(i + 1);
+
+		/* Records restored from the scan cache have no profile name */
+		if (profile_info->ProfileName[0] != '\0')
+			g_hash_table_insert(index->name_index, profile_info->ProfileName, position);
+
+		if (profile_list->summary.flags[i] & WIFI_AP_SUMMARY_BSSID_VALID)
+			g_hash_table_insert(index->bssid_index, &profile_list->summary.bssid[i], position);
+
+		matches = g_hash_table_lookup(index->essid_index, profile_info->ProfileInfo.Wlan.essid);
+		g_hash_table_steal(index->essid_index, profile_info->ProfileInfo.Wlan.essid);
+		g_hash_table_insert(index->essid_index, profile_info->ProfileInfo.Wlan.essid,
+				g_slist_prepend(matches, position));
+	}
+
+	/* Another reader may have installed its index meanwhile */
+	if (g_atomic_pointer_compare_and_exchange(&profile_list->index, NULL, index) == FALSE) {
+		__libnet_free_profile_index(index);
+		index = g_atomic_pointer_get(&profile_list->index);
+	}
+
+	return index;
+}
+
+static net_profile_info_t *__libnet_lookup_profile(struct _profile_list_s *profile_list,
+		GHashTable *index, gconstpointer key)
+{
+	int position = GPOINTER_TO_INT(g_hash_table_lookup(index, key));
+
+	if (position == 0 || position > profile_list->count)
+		return NULL;
+
+	return &profile_list->profiles[position - 1];
+}
+
+/* The handle shares the snapshot of the list until it is modified */
+static int __libnet_retain_profile(struct _profile_list_s *profile_list,
+		net_profile_info_t *profile_info, wifi_ap_h *ap)
+{
+	G_LOCK(ap_table);
+	*ap = __libnet_alloc_ap_slot(profile_info, false, profile_list->snapshot);
+	G_UNLOCK(ap_table);
+
+	if (*ap == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
+	return WIFI_ERROR_NONE;
+}
+
+static gint __libnet_compare_profile_order(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+	struct _profile_sort_s *sort = user_data;
+	struct _profile_summary_s *summary = &sort->profile_list->summary;
+	int pos_a = *(const int *)a;
+	int pos_b = *(const int *)b;
+	gint rv = 0;
+
+	switch (sort->key) {
+	case WIFI_AP_SORT_KEY_RSSI:
+		rv = (gint)summary->rssi[pos_b] - (gint)summary->rssi[pos_a];
+		break;
+	case WIFI_AP_SORT_KEY_FREQUENCY:
+		rv = (summary->frequency[pos_a] > summary->frequency[pos_b]) -
+				(summary->frequency[pos_a] < summary->frequency[pos_b]);
+		break;
+	case WIFI_AP_SORT_KEY_MAX_SPEED:
+		rv = (summary->max_rate[pos_b] > summary->max_rate[pos_a]) -
+				(summary->max_rate[pos_b] < summary->max_rate[pos_a]);
+		break;
+	case WIFI_AP_SORT_KEY_ESSID:
+		rv = strcmp(sort->profile_list->profiles[pos_a].ProfileInfo.Wlan.essid,
+				sort->profile_list->profiles[pos_b].ProfileInfo.Wlan.essid);
+		break;
+	}
+
+	/* Ties keep the order of the list, so every key is a strict total order */
+	if (rv == 0)
+		rv = pos_a - pos_b;
+
+	return rv;
+}
+
+/* Moves the top_count first entries by sort->key to the front of positions */
+static void __libnet_select_profile_order(struct _profile_sort_s *sort,
+		int *positions, int count, int top_count)
+{
+	int left = 0;
+	int right = count - 1;
+	int target = top_count - 1;
+
+	while (left < right) {
+		int pivot = positions[left + (right - left) / 2];
+		int i = left;
+		int j = right;
+		int tmp;
+
+		while (i <= j) {
+			while (__libnet_compare_profile_order(&positions[i], &pivot, sort) < 0)
+				i++;
+			while (__libnet_compare_profile_order(&positions[j], &pivot, sort) > 0)
+				j--;
+
+			if (i <= j) {
+				tmp = positions[i];
+				positions[i] = positions[j];
+				positions[j] = tmp;
+				i++;
+				j--;
+			}
+		}
+
+		if (target <= j)
+			right = j;
+		else if (target >= i)
+			left = i;
+		else
+			break;
+	}
+}
+
+static void __libnet_sift_profile_order(struct _profile_sort_s *sort,
+		int *positions, int root, int count)
+{
+	int child;
+	int tmp;
+
+	while ((child = root * 2 + 1) < count) {
+		if (child + 1 < count &&
+		    __libnet_compare_profile_order(&positions[child], &positions[child + 1], sort) < 0)
+			child++;
+
+		if (__libnet_compare_profile_order(&positions[root], &positions[child], sort) >= 0)
+			return;
+
+		tmp = positions[root];
+		positions[root] = positions[child];
+		positions[child] = tmp;
+		root = child;
+	}
+}
+
+/* Heap sort, in place and without depending on the sort helpers of GLib.
+ * Every key is a strict total order, so stability doesn't matter. */
+static void __libnet_sort_profile_order(struct _profile_sort_s *sort, int *positions, int count)
+{
+	int i;
+	int tmp;
+
+	for (i = count / 2 - 1; i >= 0; i--)
+		__libnet_sift_profile_order(sort, positions, i, count);
+
+	for (i = count - 1; i > 0; i--) {
+		tmp = positions[0];
+		positions[0] = positions[i];
+		positions[i] = tmp;
+		__libnet_sift_profile_order(sort, positions, 0, i);
+	}
+}
+
+static void __libnet_free_profile_order(struct _profile_order_s *order)
+{
+	g_free(order->positions);
+	g_free(order);
+}
+
+static struct _profile_order_s *__libnet_get_profile_order(struct _profile_list_s *profile_list,
+		wifi_ap_sort_key_e key, int top_count)
+{
+	struct _profile_order_s *cached = g_atomic_pointer_get(&profile_list->orders[key]);
+	struct _profile_sort_s sort = {profile_list, key};
+	struct _profile_order_s *order;
+	int i;
+
+	if (top_count <= 0 || top_count > profile_list->count)
+		top_count = profile_list->count;
+
+	if (cached && cached->count >= top_count)
+		return cached;
+
+	order = g_try_new0(struct _profile_order_s, 1);
+	if (order == NULL)
+		return NULL;
+
+	order->positions = g_try_new(int, profile_list->count);
+	if (order->positions == NULL) {
+		g_free(order);
+		return NULL;
+	}
+
+	for (i = 0; i < profile_list->count; i++)
+		order->positions[i] = i;
+
+	if (top_count < profile_list->count)
+		__libnet_select_profile_order(&sort, order->positions, profile_list->count, top_count);
+
+	__libnet_sort_profile_order(&sort, order->positions, top_count);
+	order->count = top_count;
+
+	while (g_atomic_pointer_compare_and_exchange(&profile_list->orders[key],
+			cached, order) == FALSE) {
+		cached = g_atomic_pointer_get(&profile_list->orders[key]);
+		if (cached->count >= top_count) {
+			__libnet_free_profile_order(order);
+			return cached;
+		}
+	}
+
+	/* Another reader may still walk the replaced order, it is freed with the list */
+	if (cached) {
+		do {
+			cached->next = g_atomic_pointer_get(&profile_list->retired_orders);
+		} while (g_atomic_pointer_compare_and_exchange(&profile_list->retired_orders,
+				cached->next, cached) == FALSE);
+	}
+
+	return order;
+}
+
+static bool __libnet_match_profile_filter(struct _profile_summary_s *summary, int position,
+		const wifi_ap_filter_s *filter)
+{
+	int security_type;
+
+	if (filter->flags & WIFI_AP_FILTER_RSSI) {
+		if ((int)summary->rssi[position] < filter->min_rssi)
+			return false;
+	}
+
+	if (filter->flags & WIFI_AP_FILTER_FREQUENCY) {
+		if ((int)summary->frequency[position] < filter->min_frequency ||
+		    (int)summary->frequency[position] > filter->max_frequency)
+			return false;
+	}
+
+	if (filter->flags & WIFI_AP_FILTER_SECURITY_TYPE) {
+		security_type = summary->security_type[position];
+		if (security_type < 0 || (filter->security_types & (1u << security_type)) == 0)
+			return false;
+	}
+
+	if (filter->flags & WIFI_AP_FILTER_FAVORITE) {
+		if (((summary->flags[position] & WIFI_AP_SUMMARY_FAVORITE) != 0) != filter->favorite)
+			return false;
+	}
+
+	if (filter->flags & WIFI_AP_FILTER_WPS_SUPPORTED) {
+		if (((summary->flags[position] & WIFI_AP_SUMMARY_WPS_SUPPORTED) != 0) != filter->wps_supported)
+			return false;
+	}
+
+	return true;
+}
+
+static void __libnet_free_profile_list(struct _profile_list_s *profile_list)
+{
+	struct _profile_order_s *order;
+	int i;
+
+	if (profile_list->handles) {
+		G_LOCK(ap_table);
+		for (i = 0; i < profile_list->count; i++)
+			__libnet_release_ap_slot(profile_list->handles[i]);
+		G_UNLOCK(ap_table);
+
+		g_free(profile_list->handles);
+	}
+
+	for (i = 0; i < WIFI_AP_SORT_KEY_NUM; i++) {
+		if (profile_list->orders[i])
+			__libnet_free_profile_order(profile_list->orders[i]);
+	}
+
+	while (profile_list->retired_orders) {
+		order = profile_list->retired_orders;
+		profile_list->retired_orders = order->next;
+		__libnet_free_profile_order(order);
+	}
+
+	__libnet_free_profile_index(profile_list->index);
+	__libnet_clear_profile_summary(&profile_list->summary);
+
+	if (profile_list->diff)
+		__libnet_unref_profile_diff(profile_list->diff);
+
+	if (profile_list->snapshot)
+		__libnet_unref_profile_snapshot(profile_list->snapshot);
+
+	g_free(profile_list);
+}
+
+/* Takes ownership of profiles */
+static struct _profile_list_s *__libnet_new_profile_list(net_profile_info_t *profiles, int count)
+{
+	struct _profile_list_s *profile_list = g_try_new0(struct _profile_list_s, 1);
+	struct _profile_snapshot_s *snapshot = g_try_new0(struct _profile_snapshot_s, 1);
+	int i;
+
+	if (profile_list && count > 0)
+		profile_list->handles = g_try_new0(wifi_ap_h, count);
+
+	if (profile_list == NULL || snapshot == NULL ||
+	    (count > 0 && profile_list->handles == NULL)) {
+		if (count > 0)
+			g_free(profiles);
+		if (profile_list)
+			g_free(profile_list->handles);
+		g_free(profile_list);
+		g_free(snapshot);
+		return NULL;
+	}
+
+	snapshot->ref_count = 1;
+	snapshot->count = count;
+	snapshot->profiles = profiles;
+
+	profile_list->count = count;
+	profile_list->profiles = profiles;
+	profile_list->snapshot = snapshot;
+
+	if (__libnet_build_profile_summary(profile_list) == false) {
+		__libnet_free_profile_list(profile_list);
+		return NULL;
+	}
+
+	G_LOCK(ap_table);
+	for (i = 0; i < count; i++) {
+		profile_list->handles[i] = __libnet_alloc_ap_slot(&profiles[i], false, snapshot);
+		if (profile_list->handles[i] == NULL) {
+			profile_list->count = i;
+			break;
+		}
+	}
+	G_UNLOCK(ap_table);
+
+	return profile_list;
+}
+
+static void __libnet_invalidate_profile_list(void)
+{
+	g_atomic_int_set(&profile_list_is_valid, FALSE);
+}
+
+static gint __libnet_enter_profile_epoch(void)
+{
+	gint epoch;
+
+	while (TRUE) {
+		epoch = g_atomic_int_get(&profile_epoch.current);
+		g_atomic_int_inc(&profile_epoch.readers[epoch]);
+
+		/* Retry if the epoch flipped before this reader was counted */
+		if (g_atomic_int_get(&profile_epoch.current) == epoch)
+			return epoch;
+
+		g_atomic_int_add(&profile_epoch.readers[epoch], -1);
+	}
+}
+
+static void __libnet_free_profile_lists(GSList *lists)
+{
+	GSList *list;
+
+	for (list = lists; list; list = list->next)
+		__libnet_free_profile_list(list->data);
+
+	g_slist_free(lists);
+}
+
+/* Called with the profile_refresh lock held */
+static void __libnet_reclaim_profile_lists(void)
+{
+	gint previous = 1 - g_atomic_int_get(&profile_epoch.current);
+
+	if (profile_epoch.draining &&
+	    g_atomic_int_get(&profile_epoch.readers[previous]) == 0) {
+		__libnet_free_profile_lists(profile_epoch.draining);
+		profile_epoch.draining = NULL;
+	}
+
+	if (profile_epoch.draining == NULL && profile_epoch.pending) {
+		profile_epoch.draining = profile_epoch.pending;
+		profile_epoch.pending = NULL;
+		g_atomic_int_set(&profile_epoch.current, previous);
+	}
+}
+
+static unsigned int __libnet_compare_profiles(net_profile_info_t *old_info, net_profile_info_t *new_info)
+{
+	net_wifi_profile_info_t *old_wlan = &old_info->ProfileInfo.Wlan;
+	net_wifi_profile_info_t *new_wlan = &new_info->ProfileInfo.Wlan;
+	unsigned int changed_fields = 0;
+
+	if (strcmp(old_wlan->essid, new_wlan->essid) != 0)
+		changed_fields |= WIFI_AP_FIELD_ESSID;
+	if (strcmp(old_wlan->bssid, new_wlan->bssid) != 0)
+		changed_fields |= WIFI_AP_FIELD_BSSID;
+	if (old_wlan->Strength != new_wlan->Strength)
+		changed_fields |= WIFI_AP_FIELD_RSSI;
+	if (old_wlan->frequency != new_wlan->frequency)
+		changed_fields |= WIFI_AP_FIELD_FREQUENCY;
+	if (old_wlan->max_rate != new_wlan->max_rate)
+		changed_fields |= WIFI_AP_FIELD_MAX_SPEED;
+	if ((old_info->Favourite != 0) != (new_info->Favourite != 0))
+		changed_fields |= WIFI_AP_FIELD_FAVORITE;
+	if (old_info->ProfileState != new_info->ProfileState)
+		changed_fields |= WIFI_AP_FIELD_CONNECTION_STATE;
+	if (old_wlan->security_info.sec_mode != new_wlan->security_info.sec_mode)
+		changed_fields |= WIFI_AP_FIELD_SECURITY_TYPE;
+	if (old_wlan->security_info.enc_mode != new_wlan->security_info.enc_mode)
+		changed_fields |= WIFI_AP_FIELD_ENCRYPTION_TYPE;
+	if ((old_wlan->PassphraseRequired != 0) != (new_wlan->PassphraseRequired != 0))
+		changed_fields |= WIFI_AP_FIELD_PASSPHRASE_REQUIRED;
+	if ((old_wlan->security_info.wps_support != 0) != (new_wlan->security_info.wps_support != 0))
+		changed_fields |= WIFI_AP_FIELD_WPS_SUPPORTED;
+
+	return changed_fields;
+}
+
+/* Returns the changes from the prev scan result to the next one */
+static struct _profile_diff_s *__libnet_new_profile_diff(struct _profile_snapshot_s *prev,
+		struct _profile_snapshot_s *next)
+{
+	struct _profile_diff_s *diff = g_try_new0(struct _profile_diff_s, 1);
+	struct _profile_change_s *changes = NULL;
+	GHashTable *prev_index = g_hash_table_new(g_str_hash, g_str_equal);
+	bool *matched = NULL;
+	int max_changes = prev->count + next->count;
+	int i, prev_pos;
+
+	if (max_changes > 0)
+		changes = g_try_new0(struct _profile_change_s, max_changes);
+	if (prev->count > 0)
+		matched = g_try_new0(bool, prev->count);
+
+	if (diff == NULL || (max_changes > 0 && changes == NULL) ||
+	    (prev->count > 0 && matched == NULL)) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't allocate the profile diff\n");
+		g_hash_table_destroy(prev_index);
+		g_free(diff);
+		g_free(changes);
+		g_free(matched);
+		return NULL;
+	}
+
+	for (i = 0; i < prev->count; i++)
+		if (prev->profiles[i].ProfileName[0] != '\0')
+			g_hash_table_insert(prev_index, prev->profiles[i].ProfileName,
+					GINT_TO_POINTER(i + 1));
+
+	for (i = 0; i < next->count; i++) {
+		prev_pos = GPOINTER_TO_INT(g_hash_table_lookup(prev_index,
+				next->profiles[i].ProfileName)) - 1;
+
+		if (prev_pos < 0) {
+			changes[diff->count].index = i;
+			changes[diff->count].type = WIFI_AP_CHANGE_TYPE_ADDED;
+			changes[diff->count].changed_fields = WIFI_AP_FIELD_ALL;
+			diff->count++;
+			continue;
+		}
+
+		matched[prev_pos] = true;
+		changes[diff->count].changed_fields = __libnet_compare_profiles(
+				&prev->profiles[prev_pos], &next->profiles[i]);
+
+		if (changes[diff->count].changed_fields != 0) {
+			changes[diff->count].index = i;
+			changes[diff->count].type = WIFI_AP_CHANGE_TYPE_UPDATED;
+			diff->count++;
+		}
+	}
+
+	for (i = 0; i < prev->count; i++) {
+		if (matched[i])
+			continue;
+
+		changes[diff->count].index = i;
+		changes[diff->count].type = WIFI_AP_CHANGE_TYPE_REMOVED;
+		changes[diff->count].changed_fields = WIFI_AP_FIELD_ALL;
+		diff->count++;
+	}
+
+	g_hash_table_destroy(prev_index);
+	g_free(matched);
+
+	diff->ref_count = 1;
+	diff->prev = __libnet_ref_profile_snapshot(prev);
+	diff->next = __libnet_ref_profile_snapshot(next);
+	diff->changes = changes;
+	WIFI_LOG(WIFI_INFO, "Wifi profile changes : %d\n", diff->count);
+
+	return diff;
+}
+
+/* Called with the profile_refresh lock held. A list fetched after a scan
+ * gets the changes against the previous scan result, any other list keeps
+ * the changes of the list it replaces. The first live list is only the base
+ * of the next diff, so a stale list loaded from the scan cache is never
+ * compared. */
+static void __libnet_update_profile_diff(struct _profile_list_s *old_list,
+		struct _profile_list_s *new_list)
+{
+	bool scanned = g_atomic_int_compare_and_exchange(&profile_list_scanned, TRUE, FALSE);
+
+	if (last_scan_snapshot == NULL) {
+		last_scan_snapshot = __libnet_ref_profile_snapshot(new_list->snapshot);
+		return;
+	}
+
+	if (scanned == false) {
+		if (old_list && old_list->diff) {
+			g_atomic_int_inc(&old_list->diff->ref_count);
+			new_list->diff = old_list->diff;
+		}
+		return;
+	}
+
+	new_list->diff = __libnet_new_profile_diff(last_scan_snapshot, new_list->snapshot);
+
+	__libnet_unref_profile_snapshot(last_scan_snapshot);
+	last_scan_snapshot = __libnet_ref_profile_snapshot(new_list->snapshot);
+}
+
+static bool __libnet_is_profile_connected(net_profile_info_t *profile_info)
+{
+	return profile_info->ProfileState == NET_STATE_TYPE_ONLINE ||
+		profile_info->ProfileState == NET_STATE_TYPE_READY;
+}
+
+/* Called with the ap_table lock held */
+static void __libnet_set_connected_ap(int state, struct _profile_snapshot_s *snapshot,
+		net_profile_info_t *ap_info)
+{
+	if (connected_ap.snapshot)
+		__libnet_unref_profile_snapshot(connected_ap.snapshot);
+
+	connected_ap.state = state;
+	connected_ap.snapshot = snapshot ? __libnet_ref_profile_snapshot(snapshot) : NULL;
+	connected_ap.ap_info = ap_info;
+}
+
+static void __libnet_update_connected_ap(int state)
+{
+	G_LOCK(ap_table);
+	connected_ap.event_count++;
+	__libnet_set_connected_ap(state, NULL, NULL);
+	G_UNLOCK(ap_table);
+}
+
+/* Event data doesn't outlive the callback, so the profile gets a snapshot of its own */
+static void __libnet_open_connected_ap(net_profile_info_t *profile_info)
+{
+	struct _profile_snapshot_s *snapshot = NULL;
+
+	if (profile_info)
+		snapshot = g_try_new0(struct _profile_snapshot_s, 1);
+
+	if (snapshot) {
+		snapshot->profiles = g_try_new(net_profile_info_t, 1);
+		if (snapshot->profiles == NULL) {
+			g_free(snapshot);
+			snapshot = NULL;
+		}
+	}
+
+	if (snapshot == NULL) {
+		__libnet_update_connected_ap(WIFI_CONNECTED_AP_UNKNOWN);
+		return;
+	}
+
+	snapshot->ref_count = 1;
+	snapshot->count = 1;
+	memcpy(snapshot->profiles, profile_info, sizeof(net_profile_info_t));
+
+	G_LOCK(ap_table);
+	connected_ap.event_count++;
+	__libnet_set_connected_ap(WIFI_CONNECTED_AP_KNOWN, snapshot, snapshot->profiles);
+	G_UNLOCK(ap_table);
+
+	__libnet_unref_profile_snapshot(snapshot);
+}
+
+static void __libnet_close_connected_ap(const char *profile_name)
+{
+	G_LOCK(ap_table);
+	connected_ap.event_count++;
+	if (connected_ap.state == WIFI_CONNECTED_AP_KNOWN &&
+	    g_strcmp0(connected_ap.ap_info->ProfileName, profile_name) == 0)
+		__libnet_set_connected_ap(WIFI_CONNECTED_AP_NONE, NULL, NULL);
+	G_UNLOCK(ap_table);
+}
+
+static void __libnet_change_connected_ap_state(const char *profile_name, net_state_type_t state)
+{
+	G_LOCK(ap_table);
+	connected_ap.event_count++;
+
+	if (connected_ap.state == WIFI_CONNECTED_AP_KNOWN &&
+	    g_strcmp0(connected_ap.ap_info->ProfileName, profile_name) == 0) {
+		if (state != NET_STATE_TYPE_READY && state != NET_STATE_TYPE_ONLINE)
+			__libnet_set_connected_ap(WIFI_CONNECTED_AP_NONE, NULL, NULL);
+	} else if (state == NET_STATE_TYPE_READY || state == NET_STATE_TYPE_ONLINE) {
+		/* Another profile came up, its info comes with the open event or a refresh */
+		__libnet_set_connected_ap(WIFI_CONNECTED_AP_UNKNOWN, NULL, NULL);
+	}
+
+	G_UNLOCK(ap_table);
+}
+
+/* Fills the cache from a fetched list unless an event came during the fetch */
+static void __libnet_refresh_connected_ap(struct _profile_list_s *profile_list, guint event_count)
+{
+	net_profile_info_t *ap_info = NULL;
+	int i;
+
+	for (i = 0; i < profile_list->count; i++) {
+		if (__libnet_is_profile_connected(&profile_list->profiles[i])) {
+			ap_info = &profile_list->profiles[i];
+			break;
+		}
+	}
+
+	G_LOCK(ap_table);
+	if (connected_ap.event_count == event_count) {
+		if (ap_info)
+			__libnet_set_connected_ap(WIFI_CONNECTED_AP_KNOWN, profile_list->snapshot, ap_info);
+		else
+			__libnet_set_connected_ap(WIFI_CONNECTED_AP_NONE, NULL, NULL);
+	}
+	G_UNLOCK(ap_table);
+}
+
+static int __libnet_copy_profile_list(struct _profile_list_s *profile_list,
+		wifi_ap_info_s **buf, int *count)
+{
+	int i;
+
+	*buf = NULL;
+	*count = profile_list ? profile_list->count : 0;
 
-struct _wifi_cb_s {
-	wifi_device_state_changed_cb device_state_cb;
-	void *device_state_user_data;
-	wifi_scan_finished_cb bg_scan_cb;
-	void *bg_scan_user_data;
-	wifi_scan_finished_cb scan_request_cb;
-	void *scan_request_user_data;
-	wifi_connection_state_changed_cb connection_state_cb;
-	void *connection_state_user_data;
-};
+	if (*count == 0)
+		return WIFI_ERROR_NONE;
 
-struct _profile_list_s {
-	int count;
-	net_profile_info_t *profiles;
-};
+	*buf = g_try_new0(wifi_ap_info_s, *count);
+	if (*buf == NULL) {
+		*count = 0;
+		return WIFI_ERROR_OUT_OF_MEMORY;
+	}
 
-static struct _wifi_cb_s wifi_callbacks = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
-static struct _profile_list_s profile_iterator = {0, NULL};
+	for (i = 0; i < *count; i++)
+		_wifi_fill_ap_info(&profile_list->profiles[i], &(*buf)[i], WIFI_AP_FIELD_ALL);
+
+	return WIFI_ERROR_NONE;
+}
+
+/* Runs in scan_cache_pool, so the file is never written by the thread
+ * that refreshed the list. It drops the reference passed by the caller. */
+static void __libnet_run_scan_cache_store(gpointer data, gpointer user_data)
+{
+	struct _profile_snapshot_s *snapshot = data;
+	wifi_ap_info_s *records = NULL;
+	char *path;
+	int i;
+
+	G_LOCK(scan_cache);
+	path = g_strdup(scan_cache_path);
+	G_UNLOCK(scan_cache);
+
+	if (path && snapshot->count > 0)
+		records = g_try_new0(wifi_ap_info_s, snapshot->count);
+
+	if (path && (records || snapshot->count == 0)) {
+		for (i = 0; i < snapshot->count; i++)
+			_wifi_fill_ap_info(&snapshot->profiles[i], &records[i], WIFI_AP_FIELD_ALL);
+
+		_wifi_scan_cache_store(path, records, snapshot->count);
+	}
+
+	g_free(records);
+	g_free(path);
+	__libnet_unref_profile_snapshot(snapshot);
+}
+
+/* Takes over a reference to snapshot */
+static void __libnet_store_scan_cache(struct _profile_snapshot_s *snapshot)
+{
+	gboolean queued = FALSE;
+
+	G_LOCK(scan_cache);
+	if (scan_cache_pool == NULL)
+		scan_cache_pool = g_thread_pool_new(__libnet_run_scan_cache_store,
+				NULL, 1, FALSE, NULL);
+	if (scan_cache_pool)
+		queued = g_thread_pool_push(scan_cache_pool, snapshot, NULL);
+	G_UNLOCK(scan_cache);
+
+	if (queued == FALSE) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't queue the scan cache store\n");
+		__libnet_unref_profile_snapshot(snapshot);
+	}
+}
+
+/* The profile list is fetched again only after an event has invalidated it,
+ * so repeated reads between scans don't cost an IPC. The new list is built
+ * aside and published with one pointer store. A reader that finds another
+ * thread refreshing keeps reading the current list instead of waiting,
+ * unless there is no list yet. */
+static void __libnet_update_profile_list(void)
+{
+	struct _profile_list_s *old_list;
+	struct _profile_list_s *new_list;
+	net_profile_info_t *profiles = NULL;
+	int count = 0;
+	guint event_count;
+	struct _profile_snapshot_s *store_snapshot = NULL;
+
+	/* Without a list there is nothing to read meanwhile, so wait for it */
+	if (g_atomic_pointer_get(&current_profile_list) == NULL)
+		G_LOCK(profile_refresh);
+	else if (G_TRYLOCK(profile_refresh) == FALSE)
+		return;
+
+	__libnet_reclaim_profile_lists();
+
+	if (g_atomic_int_get(&profile_list_is_valid)) {
+		G_UNLOCK(profile_refresh);
+		return;
+	}
+
+	/* An event arriving during the fetch invalidates the result again */
+	g_atomic_int_set(&profile_list_is_valid, TRUE);
+
+	G_LOCK(ap_table);
+	event_count = connected_ap.event_count;
+	G_UNLOCK(ap_table);
+
+	if (net_get_profile_list(NET_DEVICE_WIFI, &profiles, &count) != NET_ERR_NONE) {
+		WIFI_LOG(WIFI_ERROR, "Error!! net_get_profile_list() failed.\n");
+		__libnet_invalidate_profile_list();
+		G_UNLOCK(profile_refresh);
+		return;
+	}
+
+	new_list = __libnet_new_profile_list(profiles, count);
+	if (new_list == NULL) {
+		__libnet_invalidate_profile_list();
+		G_UNLOCK(profile_refresh);
+		return;
+	}
+
+	old_list = current_profile_list;
+	__libnet_update_profile_diff(old_list, new_list);
+
+	new_list->version = ++profile_list_version;
+	g_atomic_pointer_set(&current_profile_list, new_list);
+	g_atomic_int_set(&profile_list_is_stale, FALSE);
+
+	__libnet_refresh_connected_ap(new_list, event_count);
+
+	if (old_list)
+		profile_epoch.pending = g_slist_prepend(profile_epoch.pending, old_list);
+
+	__libnet_reclaim_profile_lists();
+
+	WIFI_LOG(WIFI_INFO, "Wifi profile count : %d, version : %u\n",
+			new_list->count, new_list->version);
+
+	if (g_atomic_int_compare_and_exchange(&scan_cache_dirty, TRUE, FALSE))
+		store_snapshot = __libnet_ref_profile_snapshot(new_list->snapshot);
+
+	G_UNLOCK(profile_refresh);
+
+	if (store_snapshot)
+		__libnet_store_scan_cache(store_snapshot);
+}
+
+/* Returns the current list, or NULL if none could be fetched. The list stays
+ * valid until __libnet_end_profile_list_read() even if it is replaced. */
+static struct _profile_list_s *__libnet_begin_profile_list_read(gint *epoch)
+{
+	__libnet_update_profile_list();
+
+	*epoch = __libnet_enter_profile_epoch();
+
+	return g_atomic_pointer_get(&current_profile_list);
+}
 
+static void __libnet_end_profile_list_read(gint epoch)
+{
+	g_atomic_int_add(&profile_epoch.readers[epoch], -1);
+}
+
+/* NULL stands for the default main context of the application */
+static GMainContext *__libnet_get_callback_context(void)
+{
+	if (event_thread.callback_context)
+		return event_thread.callback_context;
+
+	return event_thread.context;
+}
+
+/* The event fd tells a poll loop that the callback context has work */
+static void __libnet_attach_source(GSource *source, GMainContext *context)
+{
+	guint64 value = 1;
 
-static void __libnet_clear_profile_list(struct _profile_list_s *profile_list)
+	g_source_attach(source, context);
+
+	if (event_fd >= 0 && context == event_thread.callback_context &&
+	    write(event_fd, &value, sizeof(value)) < 0)
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't signal the event fd [%d]\n", errno);
+}
+
+/* Without a thread default context a poll loop integration still gets its
+ * completions through the event fd */
+static GMainContext *__libnet_ref_caller_context(void)
+{
+	if (event_fd >= 0 && g_main_context_get_thread_default() == NULL)
+		return g_main_context_ref(event_thread.callback_context);
+
+	return g_main_context_ref_thread_default();
+}
+
+/* Replaces the cached list with a live one once the main loop is idle, and
+ * tells the background scan callback that the result has changed */
+static gboolean __libnet_refresh_stale_profile_list(gpointer user_data)
 {
-	if (profile_list->count > 0)
-		g_free(profile_list->profiles);
+	if (g_atomic_int_get(&profile_list_is_stale) == FALSE)
+		return FALSE;
+
+	__libnet_invalidate_profile_list();
+	__libnet_update_profile_list();
 
-	profile_list->count = 0;
-	profile_list->profiles = NULL;
+	if (g_atomic_int_get(&profile_list_is_stale) == FALSE &&
+	    wifi_callbacks.bg_scan_cb != NULL)
+		wifi_callbacks.bg_scan_cb(WIFI_ERROR_NONE, wifi_callbacks.bg_scan_user_data);
+
+	return FALSE;
 }
 
-static void __libnet_update_profile_iterator(void)
+/* Publishes the last stored scan result as a valid but stale list, so the
+ * first reads after initialization don't wait for net_get_profile_list() */
+static void __libnet_load_scan_cache(void)
 {
-	struct _profile_list_s wifi_profiles = {0, NULL};
+	struct _profile_list_s *profile_list;
+	net_profile_info_t *profiles = NULL;
+	int count = 0;
+	int rv = WIFI_ERROR_OPERATION_FAILED;
+
+	G_LOCK(scan_cache);
+	if (scan_cache_path)
+		rv = _wifi_scan_cache_load(scan_cache_path, &profiles, &count);
+	G_UNLOCK(scan_cache);
+
+	if (rv != WIFI_ERROR_NONE)
+		return;
 
-	__libnet_clear_profile_list(&profile_iterator);
+	profile_list = __libnet_new_profile_list(profiles, count);
+	if (profile_list == NULL)
+		return;
 
-	net_get_profile_list(NET_DEVICE_WIFI, &wifi_profiles.profiles, &wifi_profiles.count);
-	WIFI_LOG(WIFI_INFO, "Wifi profile count : %d\n", wifi_profiles.count);
+	G_LOCK(profile_refresh);
+	if (current_profile_list == NULL) {
+		profile_list->version = ++profile_list_version;
+		g_atomic_pointer_set(&current_profile_list, profile_list);
+		g_atomic_int_set(&profile_list_is_stale, TRUE);
+		g_atomic_int_set(&profile_list_is_valid, TRUE);
+		profile_list = NULL;
+	}
+	G_UNLOCK(profile_refresh);
 
-	if (wifi_profiles.count == 0)
+	if (profile_list) {
+		__libnet_free_profile_list(profile_list);
 		return;
+	}
+
+	scan_cache_refresh_source = g_idle_source_new();
+	g_source_set_callback(scan_cache_refresh_source, __libnet_refresh_stale_profile_list, NULL, NULL);
+	__libnet_attach_source(scan_cache_refresh_source, __libnet_get_callback_context());
+}
+
+static char *__libnet_get_list_intf_name(struct _profile_list_s *profile_list)
+{
+	int i;
+
+	for (i = 0; profile_list && i < profile_list->count; i++) {
+		if (profile_list->profiles[i].ProfileInfo.Wlan.net_info.DevName[0] != '\0')
+			return g_strdup(profile_list->profiles[i].ProfileInfo.Wlan.net_info.DevName);
+	}
+
+	return NULL;
+}
+
+/* A wireless interface has a wireless directory in sysfs. P2P interfaces are
+ * skipped, and the first name in byte order wins if there are several. */
+static char *__libnet_get_sysfs_intf_name(void)
+{
+	GDir *dir = g_dir_open("/sys/class/net", 0, NULL);
+	const char *entry;
+	char *path;
+	char *name = NULL;
+
+	if (dir == NULL)
+		return NULL;
+
+	while ((entry = g_dir_read_name(dir)) != NULL) {
+		if (g_str_has_prefix(entry, "p2p"))
+			continue;
+
+		if (name && strcmp(entry, name) >= 0)
+			continue;
+
+		path = g_strdup_printf("/sys/class/net/%s/wireless", entry);
+		if (g_file_test(path, G_FILE_TEST_IS_DIR)) {
+			g_free(name);
+			name = g_strdup(entry);
+		}
+		g_free(path);
+	}
+
+	g_dir_close(dir);
+
+	return name;
+}
+
+/* Called with the intf_name lock held. Tries the list already fetched, then
+ * sysfs, and fetches the list only if both fail. */
+static char *__libnet_find_intf_name(void)
+{
+	struct _profile_list_s *profile_list;
+	char *name;
+	gint epoch;
+
+	epoch = __libnet_enter_profile_epoch();
+	name = __libnet_get_list_intf_name(g_atomic_pointer_get(&current_profile_list));
+	__libnet_end_profile_list_read(epoch);
+
+	if (name == NULL)
+		name = __libnet_get_sysfs_intf_name();
+
+	if (name == NULL) {
+		profile_list = __libnet_begin_profile_list_read(&epoch);
+		name = __libnet_get_list_intf_name(profile_list);
+		__libnet_end_profile_list_read(epoch);
+	}
 
-	profile_iterator.count = wifi_profiles.count;
-	profile_iterator.profiles = wifi_profiles.profiles;
+	if (name)
+		WIFI_LOG(WIFI_INFO, "Wi-Fi interface : %s\n", name);
+
+	return name;
+}
+
+static void __libnet_clear_intf_name(void)
+{
+	G_LOCK(intf_name);
+	g_free(cached_intf_name);
+	cached_intf_name = NULL;
+	G_UNLOCK(intf_name);
 }
 
 static void __libnet_convert_profile_info_to_wifi_info(net_wifi_connection_info_t *wifi_info,
@@ -99,13 +1614,22 @@ static void __libnet_state_changed_cb(char *profile_name, net_profile_info_t *pr
 		return;
 	}
 
-	ap_handle_list = g_slist_append(ap_handle_list, (wifi_ap_h)profile_info);
+	if (wifi_callbacks.connection_state_cb == NULL)
+		return;
 
-	if (wifi_callbacks.connection_state_cb)
-		wifi_callbacks.connection_state_cb(error, state, (wifi_ap_h)profile_info,
-				is_requested, wifi_callbacks.connection_state_user_data);
+	G_LOCK(ap_table);
+	wifi_ap_h ap_h = __libnet_alloc_ap_slot(profile_info, false, NULL);
+	G_UNLOCK(ap_table);
+
+	if (ap_h == NULL)
+		return;
+
+	wifi_callbacks.connection_state_cb(error, state, ap_h,
+			is_requested, wifi_callbacks.connection_state_user_data);
 
-	ap_handle_list = g_slist_remove(ap_handle_list, (wifi_ap_h)profile_info);
+	G_LOCK(ap_table);
+	__libnet_release_ap_slot(ap_h);
+	G_UNLOCK(ap_table);
 }
 
 static void __libnet_power_on_off_cb(net_event_info_t *event_cb, bool is_requested)
@@ -137,34 +1661,471 @@ static void __libnet_power_on_off_cb(net_event_info_t *event_cb, bool is_request
 		state = WIFI_DEVICE_STATE_DEACTIVATED;
 	}
 
-	wifi_callbacks.device_state_cb(error_code, state, is_requested, wifi_callbacks.device_state_user_data);
+	wifi_callbacks.device_state_cb(error_code, state, is_requested, wifi_callbacks.device_state_user_data);
+}
+
+static void __libnet_scan_cb(net_event_info_t *event_cb, bool is_requested)
+{
+	wifi_error_e error_code = WIFI_ERROR_NONE;
+
+	if (event_cb->Error != NET_ERR_NONE) {
+		WIFI_LOG(WIFI_ERROR, "Scan failed!, Error [%d]\n", event_cb->Error);
+		error_code = WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	if (wifi_callbacks.scan_request_cb) {
+		wifi_callbacks.scan_request_cb(error_code, wifi_callbacks.scan_request_user_data);
+		wifi_callbacks.scan_request_cb = NULL;
+		wifi_callbacks.scan_request_user_data = NULL;
+		return;
+	}
+
+	if (wifi_callbacks.bg_scan_cb != NULL)
+		wifi_callbacks.bg_scan_cb(error_code, wifi_callbacks.bg_scan_user_data);
+}
+
+static int __libnet_add_request(net_event_t event, net_profile_info_t *ap_info,
+		wifi_request_completed_cb callback, void *user_data)
+{
+	struct _connection_request_s *request = g_try_new0(struct _connection_request_s, 1);
+
+	if (request == NULL)
+		return 0;
+
+	request->id = g_atomic_int_add(&last_request_id, 1) + 1;
+	request->event = event;
+	/* Mirrors _wifi_libnet_open_profile(), the daemon names a profile opened by Wi-Fi info */
+	if (event != NET_EVENT_OPEN_RSP ||
+	    (_wifi_libnet_check_profile_name_validity(ap_info->ProfileName) &&
+	     ap_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X))
+		g_strlcpy(request->profile_name, ap_info->ProfileName, sizeof(request->profile_name));
+	g_strlcpy(request->essid, ap_info->ProfileInfo.Wlan.essid, sizeof(request->essid));
+	request->callback = callback;
+	request->user_data = user_data;
+
+	G_LOCK(connection_request);
+	g_queue_push_tail(&connection_requests, request);
+	G_UNLOCK(connection_request);
+
+	return request->id;
+}
+
+static void __libnet_remove_request(int request_id)
+{
+	GList *list;
+
+	G_LOCK(connection_request);
+	for (list = connection_requests.head; list; list = list->next) {
+		struct _connection_request_s *request = list->data;
+
+		if (request->id == request_id) {
+			g_queue_remove(&connection_requests, request);
+			g_free(request);
+			break;
+		}
+	}
+	G_UNLOCK(connection_request);
+}
+
+/* Takes the oldest request answered by event_cb. A request by profile name
+ * is preferred, then one by Wi-Fi info for the same essid. When the essid of
+ * the event is unknown, requests by Wi-Fi info are left pending. */
+static struct _connection_request_s *__libnet_take_request(net_event_t event,
+		const char *profile_name, net_profile_info_t *profile_info)
+{
+	struct _connection_request_s *found = NULL;
+	struct _connection_request_s *request;
+	GList *list;
+
+	G_LOCK(connection_request);
+
+	for (list = connection_requests.head; list && found == NULL; list = list->next) {
+		request = list->data;
+		if (request->event == event &&
+		    strcmp(request->profile_name, profile_name) == 0)
+			found = request;
+	}
+
+	if (profile_info && profile_info->ProfileInfo.Wlan.essid[0] != '\0') {
+		for (list = connection_requests.head; list && found == NULL; list = list->next) {
+			request = list->data;
+			if (request->event == event && request->profile_name[0] == '\0' &&
+			    strcmp(request->essid, profile_info->ProfileInfo.Wlan.essid) == 0)
+				found = request;
+		}
+	}
+
+	if (found)
+		g_queue_remove(&connection_requests, found);
+
+	G_UNLOCK(connection_request);
+
+	return found;
+}
+
+static void __libnet_complete_request(net_event_t event, const char *profile_name,
+		net_profile_info_t *profile_info, wifi_error_e error)
+{
+	struct _connection_request_s *request = __libnet_take_request(event, profile_name, profile_info);
+	wifi_ap_h ap_h = NULL;
+
+	if (request == NULL)
+		return;
+
+	if (profile_info) {
+		G_LOCK(ap_table);
+		ap_h = __libnet_alloc_ap_slot(profile_info, false, NULL);
+		G_UNLOCK(ap_table);
+	}
+
+	WIFI_LOG(WIFI_INFO, "Request %d completed [%d]\n", request->id, error);
+
+	request->callback(request->id, error, ap_h, request->user_data);
+
+	if (ap_h) {
+		G_LOCK(ap_table);
+		__libnet_release_ap_slot(ap_h);
+		G_UNLOCK(ap_table);
+	}
+
+	g_free(request);
+}
+
+/* Pending requests fail when the library is deinitialized */
+static void __libnet_fail_requests(void)
+{
+	struct _connection_request_s *request;
+
+	while (TRUE) {
+		G_LOCK(connection_request);
+		request = g_queue_pop_head(&connection_requests);
+		G_UNLOCK(connection_request);
+
+		if (request == NULL)
+			break;
+
+		request->callback(request->id, WIFI_ERROR_OPERATION_FAILED, NULL, request->user_data);
+		g_free(request);
+	}
+}
+
+/* Looks the profile up in what is already known, without IPC. A list that has
+ * just been invalidated is still used, its state fields may be out of date. */
+static bool __libnet_find_event_profile(const char *profile_name, net_profile_info_t *profile_info)
+{
+	struct _profile_list_s *profile_list;
+	struct _profile_index_s *index;
+	net_profile_info_t *found = NULL;
+	gint epoch;
+
+	G_LOCK(ap_table);
+	if (connected_ap.state == WIFI_CONNECTED_AP_KNOWN &&
+	    g_strcmp0(connected_ap.ap_info->ProfileName, profile_name) == 0) {
+		memcpy(profile_info, connected_ap.ap_info, sizeof(net_profile_info_t));
+		found = profile_info;
+	}
+	G_UNLOCK(ap_table);
+
+	if (found)
+		return true;
+
+	epoch = __libnet_enter_profile_epoch();
+
+	profile_list = g_atomic_pointer_get(&current_profile_list);
+	if (profile_list) {
+		index = __libnet_get_profile_index(profile_list);
+		if (index)
+			found = __libnet_lookup_profile(profile_list, index->name_index, profile_name);
+		if (found)
+			memcpy(profile_info, found, sizeof(net_profile_info_t));
+	}
+
+	__libnet_end_profile_list_read(epoch);
+
+	return found != NULL;
+}
+
+static void __libnet_record_event_latency(gint64 event_time, bool deferred)
+{
+	guint64 latency = g_get_monotonic_time() - event_time;
+
+	G_LOCK(event_latency);
+	event_latency.count++;
+	if (deferred)
+		event_latency.deferred++;
+	event_latency.total_us += latency;
+	if (latency > event_latency.max_us)
+		event_latency.max_us = latency;
+	G_UNLOCK(event_latency);
+}
+
+static void __libnet_dispatch_connection_event(struct _connection_event_s *event)
+{
+	net_profile_info_t *profile_info = event->has_profile ? &event->profile_info : NULL;
+
+	__libnet_state_changed_cb(event->profile_name, profile_info,
+				event->error, event->state, event->is_requested);
+	if (event->is_requested)
+		__libnet_complete_request(event->event, event->profile_name, profile_info, event->error);
+
+	__libnet_record_event_latency(event->time, event->fetch);
+}
+
+static gboolean __libnet_dispatch_queued_connection_event(gpointer user_data)
+{
+	__libnet_dispatch_connection_event(user_data);
+	g_atomic_int_add(&connection_events_queued, -1);
+
+	return FALSE;
+}
+
+static void __libnet_free_connection_event(gpointer user_data)
+{
+	struct _connection_event_s *event = user_data;
+
+	g_main_context_unref(event->context);
+	g_free(event);
+}
+
+/* Runs in the event thread. Events are handed back to the dispatching context
+ * in the order they were queued. */
+static void __libnet_run_connection_event(gpointer data, gpointer user_data)
+{
+	struct _connection_event_s *event = data;
+	GSource *source;
+
+	if (event->fetch &&
+	    net_get_profile_info(event->profile_name, &event->profile_info) == NET_ERR_NONE) {
+		if (event->profile_state != NET_STATE_TYPE_UNKNOWN)
+			event->profile_info.ProfileState = event->profile_state;
+		event->has_profile = true;
+	}
+
+	source = g_idle_source_new();
+	g_source_set_callback(source, __libnet_dispatch_queued_connection_event, event,
+			__libnet_free_connection_event);
+	__libnet_attach_source(source, event->context);
+	g_source_unref(source);
+}
+
+/* Invokes the callbacks of a connection event at once when its profile is
+ * known. Otherwise the profile is fetched in the event thread, and every
+ * later event queues behind it so that callbacks keep the order of events.
+ * Unless profile_state is NET_STATE_TYPE_UNKNOWN, it replaces the state of
+ * the profile, which may still be the one from before the event. */
+static void __libnet_post_connection_event(net_event_t type, const char *profile_name,
+		net_profile_info_t *profile_info, net_state_type_t profile_state,
+		wifi_error_e error, wifi_connection_state_e state,
+		bool is_requested, gint64 event_time)
+{
+	struct _connection_event_s *event = g_try_new0(struct _connection_event_s, 1);
+	gboolean queued = FALSE;
+
+	if (event == NULL)
+		return;
+
+	event->event = type;
+	g_strlcpy(event->profile_name, profile_name, sizeof(event->profile_name));
+	event->error = error;
+	event->state = state;
+	event->profile_state = profile_state;
+	event->is_requested = is_requested;
+	event->time = event_time;
+
+	if (profile_info) {
+		memcpy(&event->profile_info, profile_info, sizeof(net_profile_info_t));
+		event->has_profile = true;
+	} else {
+		event->has_profile = __libnet_find_event_profile(event->profile_name, &event->profile_info);
+	}
+
+	if (event->has_profile && profile_state != NET_STATE_TYPE_UNKNOWN)
+		event->profile_info.ProfileState = profile_state;
+
+	event->fetch = !event->has_profile;
+
+	if (event->fetch == false && g_atomic_int_get(&connection_events_queued) == 0) {
+		__libnet_dispatch_connection_event(event);
+		g_free(event);
+		return;
+	}
+
+	event->context = __libnet_ref_caller_context();
+	g_atomic_int_inc(&connection_events_queued);
+
+	G_LOCK(connection_event);
+	if (connection_event_pool == NULL)
+		connection_event_pool = g_thread_pool_new(__libnet_run_connection_event,
+				NULL, 1, FALSE, NULL);
+	if (connection_event_pool)
+		queued = g_thread_pool_push(connection_event_pool, event, NULL);
+	G_UNLOCK(connection_event);
+
+	if (queued == FALSE) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't queue the connection event\n");
+		g_atomic_int_add(&connection_events_queued, -1);
+		__libnet_free_connection_event(event);
+	}
+}
+
+static void __libnet_deliver_state_event(struct _state_event_s *state_event)
+{
+	G_LOCK(state_event);
+	state_event_stats.delivered++;
+	G_UNLOCK(state_event);
+
+	__libnet_post_connection_event(NET_EVENT_NET_STATE_IND, state_event->profile_name,
+			NULL, state_event->state, WIFI_ERROR_NONE, WIFI_CONNECTION_STATE_CONNECTING,
+			state_event->is_requested, state_event->time);
+}
+
+static void __libnet_free_state_event(gpointer user_data)
+{
+	struct _state_event_s *state_event = user_data;
+
+	g_source_destroy(state_event->timer);
+	g_source_unref(state_event->timer);
+	g_free(state_event);
+}
+
+/* Takes the coalesced state of the profile out of the window. Without a
+ * name, only the window of the given serial matches. */
+static bool __libnet_take_state_event(const char *profile_name, guint serial,
+		struct _state_event_s *state_event)
+{
+	struct _state_event_s *pending = NULL;
+	GHashTableIter iter;
+	gpointer value;
+
+	G_LOCK(state_event);
+	if (pending_state_events && profile_name) {
+		pending = g_hash_table_lookup(pending_state_events, profile_name);
+	} else if (pending_state_events) {
+		g_hash_table_iter_init(&iter, pending_state_events);
+		while (pending == NULL && g_hash_table_iter_next(&iter, NULL, &value))
+			if (((struct _state_event_s *)value)->serial == serial)
+				pending = value;
+	}
+
+	if (pending) {
+		memcpy(state_event, pending, sizeof(struct _state_event_s));
+		state_event->timer = NULL;
+		g_hash_table_remove(pending_state_events, pending->profile_name);
+	}
+	G_UNLOCK(state_event);
+
+	return pending != NULL;
+}
+
+static gboolean __libnet_state_event_timeout(gpointer user_data)
+{
+	struct _state_event_s state_event;
+
+	if (__libnet_take_state_event(NULL, GPOINTER_TO_UINT(user_data), &state_event))
+		__libnet_deliver_state_event(&state_event);
+
+	return FALSE;
+}
+
+/* A poll loop only wakes up for the event fd, so the timer runs in the event
+ * thread and hands the window over to the callback context */
+static gboolean __libnet_forward_state_event_timeout(gpointer user_data)
+{
+	GSource *source = g_idle_source_new();
+
+	g_source_set_callback(source, __libnet_state_event_timeout, user_data, NULL);
+	__libnet_attach_source(source, event_thread.callback_context);
+	g_source_unref(source);
+
+	return FALSE;
 }
 
-static void __libnet_scan_cb(net_event_info_t *event_cb, bool is_requested)
+static void __libnet_flush_state_event(const char *profile_name)
 {
-	wifi_error_e error_code = WIFI_ERROR_NONE;
+	struct _state_event_s state_event;
 
-	if (event_cb->Error != NET_ERR_NONE) {
-		WIFI_LOG(WIFI_ERROR, "Scan failed!, Error [%d]\n", event_cb->Error);
-		error_code = WIFI_ERROR_OPERATION_FAILED;
+	if (__libnet_take_state_event(profile_name, 0, &state_event))
+		__libnet_deliver_state_event(&state_event);
+}
+
+/* Keeps only the latest state of a profile seen within the window. The
+ * latency of the delivered event is counted from the first one. */
+static void __libnet_queue_state_event(const char *profile_name, net_state_type_t state,
+		bool is_requested, gint64 event_time)
+{
+	struct _state_event_s *pending;
+	struct _state_event_s state_event;
+	guint window = g_atomic_int_get(&state_event_window);
+
+	G_LOCK(state_event);
+	state_event_stats.received++;
+
+	if (pending_state_events == NULL)
+		pending_state_events = g_hash_table_new_full(g_str_hash, g_str_equal,
+				NULL, __libnet_free_state_event);
+
+	pending = g_hash_table_lookup(pending_state_events, profile_name);
+	if (pending) {
+		pending->state = state;
+		pending->is_requested = pending->is_requested || is_requested;
+		G_UNLOCK(state_event);
+		return;
 	}
 
-	if (wifi_callbacks.scan_request_cb) {
-		wifi_callbacks.scan_request_cb(error_code, wifi_callbacks.scan_request_user_data);
-		wifi_callbacks.scan_request_cb = NULL;
-		wifi_callbacks.scan_request_user_data = NULL;
+	if (window > 0)
+		pending = g_try_new0(struct _state_event_s, 1);
+
+	if (pending) {
+		g_strlcpy(pending->profile_name, profile_name, sizeof(pending->profile_name));
+		pending->state = state;
+		pending->is_requested = is_requested;
+		pending->time = event_time;
+
+		if (++state_event_serial == 0)
+			state_event_serial++;
+		pending->serial = state_event_serial;
+
+		pending->timer = g_timeout_source_new(window);
+		if (event_fd >= 0) {
+			g_source_set_callback(pending->timer, __libnet_forward_state_event_timeout,
+					GUINT_TO_POINTER(pending->serial), NULL);
+			g_source_attach(pending->timer, event_thread.context);
+		} else {
+			g_source_set_callback(pending->timer, __libnet_state_event_timeout,
+					GUINT_TO_POINTER(pending->serial), NULL);
+			g_source_attach(pending->timer, g_main_context_get_thread_default());
+		}
+
+		g_hash_table_insert(pending_state_events, pending->profile_name, pending);
+		G_UNLOCK(state_event);
 		return;
 	}
+	G_UNLOCK(state_event);
 
-	if (wifi_callbacks.bg_scan_cb != NULL)
-		wifi_callbacks.bg_scan_cb(error_code, wifi_callbacks.bg_scan_user_data);
+	g_strlcpy(state_event.profile_name, profile_name, sizeof(state_event.profile_name));
+	state_event.state = state;
+	state_event.is_requested = is_requested;
+	state_event.time = event_time;
+	state_event.serial = 0;
+	state_event.timer = NULL;
+
+	__libnet_deliver_state_event(&state_event);
 }
 
-static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
+static void __libnet_clear_state_events(void)
+{
+	G_LOCK(state_event);
+	if (pending_state_events) {
+		g_hash_table_destroy(pending_state_events);
+		pending_state_events = NULL;
+	}
+	G_UNLOCK(state_event);
+}
+
+static void __libnet_handle_event(net_event_info_t *event_cb, gint64 event_time)
 {
 	bool is_requested = false;
 	net_profile_info_t *prof_info_p = NULL;
-	net_profile_info_t prof_info;
 
 	switch (event_cb->Event) {
 	case NET_EVENT_OPEN_RSP:
@@ -173,6 +2134,11 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 	case NET_EVENT_OPEN_IND:
 		if (strstr(event_cb->ProfileName, "/wifi_") == NULL) return;
 
+		__libnet_invalidate_profile_list();
+
+		/* A coalesced state of the profile is older than this event */
+		__libnet_flush_state_event(event_cb->ProfileName);
+
 		WIFI_LOG(WIFI_INFO,
 			"Received ACTIVATION(Open RSP/IND) response: %d \n", event_cb->Error);
 
@@ -183,10 +2149,12 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 			if (event_cb->Datalength == sizeof(net_profile_info_t))
 				prof_info_p = (net_profile_info_t*)event_cb->Data;
 
-			__libnet_state_changed_cb(event_cb->ProfileName, prof_info_p,
-						WIFI_ERROR_NONE,
+			__libnet_open_connected_ap(prof_info_p);
+
+			__libnet_post_connection_event(event_cb->Event, event_cb->ProfileName, prof_info_p,
+						NET_STATE_TYPE_UNKNOWN, WIFI_ERROR_NONE,
 						WIFI_CONNECTION_STATE_CONNECTED,
-						is_requested);
+						is_requested, event_time);
 			return;
 		case NET_ERR_TIME_OUT:
 			WIFI_LOG(WIFI_ERROR, "Request time out!\n");
@@ -205,16 +2173,12 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 			break;
 		}
 
-		if (net_get_profile_info(event_cb->ProfileName, &prof_info) == NET_ERR_NONE)
-			__libnet_state_changed_cb(event_cb->ProfileName, &prof_info,
-						WIFI_ERROR_OPERATION_FAILED,
-						WIFI_CONNECTION_STATE_DISCONNECTED,
-						is_requested);
-		else
-			__libnet_state_changed_cb(event_cb->ProfileName, NULL,
-						WIFI_ERROR_OPERATION_FAILED,
-						WIFI_CONNECTION_STATE_DISCONNECTED,
-						is_requested);
+		__libnet_update_connected_ap(WIFI_CONNECTED_AP_UNKNOWN);
+
+		__libnet_post_connection_event(event_cb->Event, event_cb->ProfileName, NULL,
+					NET_STATE_TYPE_FAILURE, WIFI_ERROR_OPERATION_FAILED,
+					WIFI_CONNECTION_STATE_DISCONNECTED,
+					is_requested, event_time);
 
 		break;
 	case NET_EVENT_CLOSE_RSP:
@@ -222,22 +2186,20 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 	case NET_EVENT_CLOSE_IND:
 		if (strstr(event_cb->ProfileName, "/wifi_") == NULL) return;
 
+		__libnet_invalidate_profile_list();
+		__libnet_flush_state_event(event_cb->ProfileName);
+
 		WIFI_LOG(WIFI_INFO, "Got Close RSP/IND\n");
 
 		switch (event_cb->Error) {
 		case NET_ERR_NONE:
 			/* Successful PDP Deactivation */
 			WIFI_LOG(WIFI_INFO, "Deactivation succeeded!\n");
-			if (net_get_profile_info(event_cb->ProfileName, &prof_info) == NET_ERR_NONE)
-				__libnet_state_changed_cb(event_cb->ProfileName, &prof_info,
-							WIFI_ERROR_NONE,
-							WIFI_CONNECTION_STATE_DISCONNECTED,
-							is_requested);
-			else
-				__libnet_state_changed_cb(event_cb->ProfileName, NULL,
-							WIFI_ERROR_NONE,
-							WIFI_CONNECTION_STATE_DISCONNECTED,
-							is_requested);
+			__libnet_close_connected_ap(event_cb->ProfileName);
+			__libnet_post_connection_event(event_cb->Event, event_cb->ProfileName, NULL,
+						NET_STATE_TYPE_IDLE, WIFI_ERROR_NONE,
+						WIFI_CONNECTION_STATE_DISCONNECTED,
+						is_requested, event_time);
 			return;
 		case NET_ERR_TIME_OUT:
 			WIFI_LOG(WIFI_ERROR, "Request time out!\n");
@@ -259,26 +2221,25 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 			break;
 		}
 
-		if (net_get_profile_info(event_cb->ProfileName, &prof_info) == NET_ERR_NONE)
-			__libnet_state_changed_cb(event_cb->ProfileName, &prof_info,
-						WIFI_ERROR_OPERATION_FAILED,
-						WIFI_CONNECTION_STATE_DISCONNECTED,
-						is_requested);
-		else
-			__libnet_state_changed_cb(event_cb->ProfileName, NULL,
-						WIFI_ERROR_OPERATION_FAILED,
-						WIFI_CONNECTION_STATE_DISCONNECTED,
-						is_requested);
+		/* The connection is kept, so is the state of the profile */
+		__libnet_post_connection_event(event_cb->Event, event_cb->ProfileName, NULL,
+					NET_STATE_TYPE_UNKNOWN, WIFI_ERROR_OPERATION_FAILED,
+					WIFI_CONNECTION_STATE_DISCONNECTED,
+					is_requested, event_time);
 
 		break;
 	case NET_EVENT_NET_STATE_IND:
 		if (strstr(event_cb->ProfileName, "/wifi_") == NULL) return;
 
+		__libnet_invalidate_profile_list();
+
 		WIFI_LOG(WIFI_INFO, "Got State changed IND\n");
 		net_state_type_t *profile_state = (net_state_type_t*)event_cb->Data;
 
 		if (event_cb->Error == NET_ERR_NONE &&
 		    event_cb->Datalength == sizeof(net_state_type_t)) {
+			__libnet_change_connected_ap_state(event_cb->ProfileName, *profile_state);
+
 			switch (*profile_state) {
 			case NET_STATE_TYPE_ASSOCIATION:
 				WIFI_LOG(WIFI_INFO,
@@ -303,107 +2264,706 @@ static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
 				return;
 			}
 
-			if (net_get_profile_info(event_cb->ProfileName, &prof_info) == NET_ERR_NONE)
-				__libnet_state_changed_cb(event_cb->ProfileName, &prof_info,
-							WIFI_ERROR_NONE,
-							WIFI_CONNECTION_STATE_CONNECTING,
-							is_requested);
-			else
-				__libnet_state_changed_cb(event_cb->ProfileName, NULL,
-							WIFI_ERROR_NONE,
-							WIFI_CONNECTION_STATE_CONNECTING,
-							is_requested);
-		}
+			__libnet_queue_state_event(event_cb->ProfileName, *profile_state,
+						is_requested, event_time);
+		}
+
+		break;
+	case NET_EVENT_WIFI_SCAN_RSP:
+	case NET_EVENT_WIFI_SCAN_IND:
+		WIFI_LOG(WIFI_ERROR, "Got wifi scan IND\n");
+		g_atomic_int_set(&scan_cache_dirty, TRUE);
+		g_atomic_int_set(&profile_list_scanned, TRUE);
+		__libnet_invalidate_profile_list();
+		__libnet_scan_cb(event_cb, is_requested);
+		break;
+	case NET_EVENT_WIFI_POWER_RSP:
+		is_requested = true;
+	case NET_EVENT_WIFI_POWER_IND:
+		WIFI_LOG(WIFI_ERROR, "Got wifi power IND\n");
+		__libnet_invalidate_profile_list();
+		__libnet_clear_intf_name();
+
+		if (event_cb->Error == NET_ERR_NONE &&
+		    event_cb->Datalength == sizeof(net_wifi_state_t) &&
+		    *(net_wifi_state_t *)event_cb->Data == WIFI_OFF)
+			__libnet_update_connected_ap(WIFI_CONNECTED_AP_NONE);
+		else
+			__libnet_update_connected_ap(WIFI_CONNECTED_AP_UNKNOWN);
+
+		__libnet_power_on_off_cb(event_cb, is_requested);
+		break;
+	default :
+		WIFI_LOG(WIFI_ERROR, "Error! Unknown Event\n\n");
+	}
+}
+
+static void __libnet_evt_cb(net_event_info_t *event_cb, void *user_data)
+{
+	__libnet_handle_event(event_cb, g_get_monotonic_time());
+}
+
+static gboolean __libnet_dispatch_marshalled_event(gpointer user_data)
+{
+	struct _marshalled_event_s *event = user_data;
+	GMainContext *context = event_thread.callback_context;
+
+	/* Received before the event thread was stopped */
+	if (event->generation != (guint)g_atomic_int_get(&event_thread_generation))
+		return FALSE;
+
+	/* Sources created while handling the event belong to the callback context */
+	g_main_context_push_thread_default(context);
+	__libnet_handle_event(&event->info, event->time);
+	g_main_context_pop_thread_default(context);
+
+	return FALSE;
+}
+
+static void __libnet_free_marshalled_event(gpointer user_data)
+{
+	struct _marshalled_event_s *event = user_data;
+
+	g_free(event->info.Data);
+	g_free(event);
+}
+
+/* Runs in the event thread. Idle sources of one context are dispatched in
+ * the order they were attached, so the events keep their order. */
+static void __libnet_marshal_evt_cb(net_event_info_t *event_cb, void *user_data)
+{
+	struct _marshalled_event_s *event = g_try_new0(struct _marshalled_event_s, 1);
+	GSource *source;
+
+	if (event == NULL)
+		return;
+
+	memcpy(&event->info, event_cb, sizeof(net_event_info_t));
+	event->info.Data = NULL;
+	if (event_cb->Data && event_cb->Datalength > 0) {
+		event->info.Data = g_malloc(event_cb->Datalength);
+		memcpy(event->info.Data, event_cb->Data, event_cb->Datalength);
+	}
+	event->time = g_get_monotonic_time();
+	event->generation = g_atomic_int_get(&event_thread_generation);
+
+	source = g_idle_source_new();
+	g_source_set_callback(source, __libnet_dispatch_marshalled_event, event,
+			__libnet_free_marshalled_event);
+	__libnet_attach_source(source, event_thread.callback_context);
+	g_source_unref(source);
+}
+
+static gpointer __libnet_run_event_thread(gpointer user_data)
+{
+	g_main_context_push_thread_default(event_thread.context);
+	g_main_loop_run(event_thread.loop);
+	g_main_context_pop_thread_default(event_thread.context);
+
+	return NULL;
+}
+
+static void __libnet_free_event_thread(void)
+{
+	if (event_thread.loop)
+		g_main_loop_unref(event_thread.loop);
+	if (event_thread.context)
+		g_main_context_unref(event_thread.context);
+	if (event_thread.callback_context)
+		g_main_context_unref(event_thread.callback_context);
+
+	memset(&event_thread, 0, sizeof(struct _event_thread_s));
+}
+
+/* Stops the dispatching of events. The contexts are kept until
+ * __libnet_free_event_thread(), so sources attached to them can still be
+ * destroyed. */
+static void __libnet_stop_event_thread(void)
+{
+	if (event_thread.thread == NULL)
+		return;
+
+	g_main_loop_quit(event_thread.loop);
+	g_thread_join(event_thread.thread);
+	event_thread.thread = NULL;
+	g_atomic_int_inc(&event_thread_generation);
+}
+
+/* The client is registered with the event context as the thread default, so
+ * the connection manager delivers its events to the event thread */
+static bool __libnet_register_client(void)
+{
+	net_event_cb_t event_cb = (net_event_cb_t)__libnet_evt_cb;
+	int rv;
+
+	if (event_thread.callback_context)
+		event_cb = (net_event_cb_t)__libnet_marshal_evt_cb;
+
+	if (event_thread.context)
+		g_main_context_push_thread_default(event_thread.context);
+
+	rv = net_register_client_ext(event_cb, NET_DEVICE_WIFI, NULL);
+
+	if (event_thread.context)
+		g_main_context_pop_thread_default(event_thread.context);
+
+	if (rv != NET_ERR_NONE)
+		return false;
+
+	__libnet_load_scan_cache();
+
+	return true;
+}
+
+bool _wifi_libnet_init(void)
+{
+	return __libnet_register_client();
+}
+
+bool _wifi_libnet_init_with_event_thread(void *callback_context)
+{
+	event_thread.context = g_main_context_new();
+	event_thread.loop = g_main_loop_new(event_thread.context, FALSE);
+	if (callback_context)
+		event_thread.callback_context = g_main_context_ref(callback_context);
+
+	if (__libnet_register_client() == false) {
+		__libnet_free_event_thread();
+		return false;
+	}
+
+	event_thread.thread = g_thread_try_new("wifi-event", __libnet_run_event_thread, NULL, NULL);
+	if (event_thread.thread == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't start the event thread\n");
+		net_deregister_client_ext(NET_DEVICE_WIFI);
+		__libnet_free_event_thread();
+		return false;
+	}
+
+	return true;
+}
+
+bool _wifi_libnet_init_with_event_fd(int *fd)
+{
+	GMainContext *context;
+	bool rv;
+
+	event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (event_fd < 0) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't create the event fd [%d]\n", errno);
+		return false;
+	}
+
+	context = g_main_context_new();
+	rv = _wifi_libnet_init_with_event_thread(context);
+	g_main_context_unref(context);
+
+	if (rv == false) {
+		close(event_fd);
+		event_fd = -1;
+		return false;
+	}
+
+	*fd = event_fd;
+
+	return true;
+}
+
+int _wifi_libnet_dispatch_pending(void)
+{
+	GMainContext *context;
+	guint64 value;
+
+	if (event_fd < 0)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	/* Kept alive in case a callback deinitializes Wi-Fi */
+	context = g_main_context_ref(event_thread.callback_context);
+	if (g_main_context_acquire(context) == FALSE) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Events are dispatched in another thread\n");
+		g_main_context_unref(context);
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	/* Reset first, so sources attached while dispatching signal the fd again */
+	if (read(event_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't read the event fd [%d]\n", errno);
+
+	while (g_main_context_iteration(context, FALSE))
+		;
+
+	g_main_context_release(context);
+	g_main_context_unref(context);
+
+	return WIFI_ERROR_NONE;
+}
+
+static void __libnet_drain_connection_events(void)
+{
+	GThreadPool *pool;
+
+	G_LOCK(connection_event);
+	pool = connection_event_pool;
+	connection_event_pool = NULL;
+	G_UNLOCK(connection_event);
+
+	if (pool)
+		g_thread_pool_free(pool, FALSE, TRUE);
+}
+
+bool _wifi_libnet_deinit(void)
+{
+	GThreadPool *pool;
+
+	if (event_thread.thread && event_thread.thread == g_thread_self()) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't deinitialize in the event thread\n");
+		return false;
+	}
+
+	/* Queued modifications are still sent, while the client is registered */
+	G_LOCK(profile_request);
+	pool = profile_request_pool;
+	profile_request_pool = NULL;
+	G_UNLOCK(profile_request);
+
+	if (pool)
+		g_thread_pool_free(pool, FALSE, TRUE);
+
+	/* Queued events still fetch their profiles */
+	__libnet_drain_connection_events();
+
+	if (net_deregister_client_ext(NET_DEVICE_WIFI) != NET_ERR_NONE)
+		return false;
+
+	/* No event handler runs while the shared state is torn down */
+	__libnet_stop_event_thread();
+
+	if (scan_cache_refresh_source) {
+		g_source_destroy(scan_cache_refresh_source);
+		g_source_unref(scan_cache_refresh_source);
+		scan_cache_refresh_source = NULL;
+	}
+
+	__libnet_clear_state_events();
+
+	/* The last scan result is still written to the cache */
+	G_LOCK(scan_cache);
+	pool = scan_cache_pool;
+	scan_cache_pool = NULL;
+	G_UNLOCK(scan_cache);
+
+	if (pool)
+		g_thread_pool_free(pool, FALSE, TRUE);
+
+	/* Events that arrived while the client was being deregistered */
+	__libnet_drain_connection_events();
+
+	G_LOCK(profile_refresh);
+	if (current_profile_list)
+		__libnet_free_profile_list(current_profile_list);
+	current_profile_list = NULL;
+	profile_list_is_valid = FALSE;
+	profile_list_is_stale = FALSE;
+	profile_list_scanned = FALSE;
+
+	if (last_scan_snapshot)
+		__libnet_unref_profile_snapshot(last_scan_snapshot);
+	last_scan_snapshot = NULL;
+
+	__libnet_free_profile_lists(profile_epoch.pending);
+	__libnet_free_profile_lists(profile_epoch.draining);
+	profile_epoch.pending = NULL;
+	profile_epoch.draining = NULL;
+	G_UNLOCK(profile_refresh);
+
+	G_LOCK(ap_table);
+	__libnet_set_connected_ap(WIFI_CONNECTED_AP_UNKNOWN, NULL, NULL);
+	__libnet_clear_ap_slots();
+	__libnet_shrink_ap_pool(0);
+	G_UNLOCK(ap_table);
+
+	__libnet_clear_intf_name();
+	__libnet_fail_requests();
+
+	/* Events left in the event context are dropped with it */
+	__libnet_free_event_thread();
+
+	if (event_fd >= 0) {
+		close(event_fd);
+		event_fd = -1;
+	}
+
+	memset(&wifi_callbacks, 0, sizeof(struct _wifi_cb_s));
+
+	return true;
+}
+
+int _wifi_activate(void)
+{
+	int rv;
+
+	rv = net_wifi_power_on();
+	if (rv == NET_ERR_NONE)
+		return WIFI_ERROR_NONE;
+	else if (rv == NET_ERR_INVALID_OPERATION)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	return WIFI_ERROR_OPERATION_FAILED;
+}
+
+int _wifi_deactivate(void)
+{
+	int rv;
+
+	rv = net_wifi_power_off();
+	if (rv == NET_ERR_NONE)
+		return WIFI_ERROR_NONE;
+	else if (rv == NET_ERR_INVALID_OPERATION)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	return WIFI_ERROR_OPERATION_FAILED;
+}
+
+bool _wifi_libnet_check_ap_validity(wifi_ap_h ap_h)
+{
+	bool valid;
+
+	G_LOCK(ap_table);
+	valid = __libnet_lookup_ap_slot(ap_h) != NULL;
+	G_UNLOCK(ap_table);
+
+	return valid;
+}
+
+/* The profile stays valid until the caller releases its handle */
+net_profile_info_t *_wifi_libnet_get_ap_info(wifi_ap_h ap_h)
+{
+	struct _ap_slot_s *slot;
+	net_profile_info_t *ap_info = NULL;
+
+	G_LOCK(ap_table);
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot)
+		ap_info = slot->ap_info;
+	G_UNLOCK(ap_table);
+
+	return ap_info;
+}
+
+wifi_ap_h _wifi_libnet_add_to_ap_list(net_profile_info_t *ap_info)
+{
+	wifi_ap_h ap_h;
+
+	G_LOCK(ap_table);
+	ap_h = __libnet_alloc_ap_slot(ap_info, true, NULL);
+	G_UNLOCK(ap_table);
+
+	return ap_h;
+}
+
+void _wifi_libnet_remove_from_ap_list(wifi_ap_h ap_h)
+{
+	G_LOCK(ap_table);
+	__libnet_release_ap_slot(ap_h);
+	G_UNLOCK(ap_table);
+}
+
+/* A handle into a snapshot is retained by sharing the snapshot,
+ * only handles that have their own copy are copied */
+wifi_ap_h _wifi_libnet_clone_ap(wifi_ap_h ap_h)
+{
+	struct _ap_slot_s *slot;
+	net_profile_info_t *ap_info;
+	wifi_ap_h cloned_ap = NULL;
+
+	G_LOCK(ap_table);
+
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot == NULL) {
+		G_UNLOCK(ap_table);
+		return NULL;
+	}
+
+	if (slot->snapshot) {
+		cloned_ap = __libnet_alloc_ap_slot(slot->ap_info, false, slot->snapshot);
+	} else {
+		ap_info = __libnet_get_pooled_ap_info();
+		if (ap_info) {
+			memcpy(ap_info, slot->ap_info, sizeof(net_profile_info_t));
+
+			cloned_ap = __libnet_alloc_ap_slot(ap_info, true, NULL);
+			if (cloned_ap == NULL)
+				__libnet_put_pooled_ap_info(ap_info);
+		}
+	}
+
+	G_UNLOCK(ap_table);
+
+	return cloned_ap;
+}
+
+/* Snapshots are immutable, so the first write through a handle that
+ * doesn't own its profile gives the handle a private copy */
+net_profile_info_t *_wifi_libnet_get_ap_info_for_write(wifi_ap_h ap_h)
+{
+	struct _ap_slot_s *slot;
+	net_profile_info_t *ap_info = NULL;
+
+	G_LOCK(ap_table);
+
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot && slot->owned) {
+		ap_info = slot->ap_info;
+	} else if (slot) {
+		ap_info = __libnet_get_pooled_ap_info();
+		if (ap_info) {
+			memcpy(ap_info, slot->ap_info, sizeof(net_profile_info_t));
+
+			if (slot->snapshot)
+				__libnet_unref_profile_snapshot(slot->snapshot);
+
+			slot->snapshot = NULL;
+			slot->owned = true;
+			slot->ap_info = ap_info;
+		}
+	}
+
+	G_UNLOCK(ap_table);
+
+	return ap_info;
+}
+
+int _wifi_libnet_begin_edit(wifi_ap_h ap_h)
+{
+	struct _ap_slot_s *slot;
+	int rv = WIFI_ERROR_NONE;
+
+	G_LOCK(ap_table);
 
-		break;
-	case NET_EVENT_WIFI_SCAN_RSP:
-	case NET_EVENT_WIFI_SCAN_IND:
-		WIFI_LOG(WIFI_ERROR, "Got wifi scan IND\n");
-		__libnet_scan_cb(event_cb, is_requested);
-		break;
-	case NET_EVENT_WIFI_POWER_RSP:
-		is_requested = true;
-	case NET_EVENT_WIFI_POWER_IND:
-		WIFI_LOG(WIFI_ERROR, "Got wifi power IND\n");
-		__libnet_power_on_off_cb(event_cb, is_requested);
-		break;
-	default :
-		WIFI_LOG(WIFI_ERROR, "Error! Unknown Event\n\n");
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot == NULL) {
+		rv = WIFI_ERROR_INVALID_PARAMETER;
+	} else if (slot->editing) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Already editing\n");
+		rv = WIFI_ERROR_INVALID_OPERATION;
+	} else {
+		slot->editing = true;
+		slot->dirty = false;
 	}
+
+	G_UNLOCK(ap_table);
+
+	return rv;
 }
 
-bool _wifi_libnet_init(void)
+/* Returns true if the change is deferred to _wifi_libnet_commit_edit() */
+bool _wifi_libnet_mark_ap_dirty(wifi_ap_h ap_h)
 {
-	int rv;
+	struct _ap_slot_s *slot;
+	bool editing = false;
 
-	rv = net_register_client_ext((net_event_cb_t)__libnet_evt_cb, NET_DEVICE_WIFI, NULL);
-	if (rv != NET_ERR_NONE)
-		return false;
+	G_LOCK(ap_table);
 
-	return true;
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot && slot->editing) {
+		slot->dirty = true;
+		editing = true;
+	}
+
+	G_UNLOCK(ap_table);
+
+	return editing;
 }
 
-bool _wifi_libnet_deinit(void)
+/* Ends the edit of ap_h. If something changed, the profile to send is copied
+ * to ap_info under the ap_table lock and send is set. */
+static int __libnet_end_edit(wifi_ap_h ap_h, net_profile_info_t *ap_info, bool *send)
 {
-	if (net_deregister_client_ext(NET_DEVICE_WIFI) != NET_ERR_NONE)
-		return false;
+	struct _ap_slot_s *slot;
+	bool dirty;
 
-	__libnet_clear_profile_list(&profile_iterator);
-	g_slist_free_full(ap_handle_list, g_free);
-	memset(&wifi_callbacks, 0, sizeof(struct _wifi_cb_s));
+	*send = false;
 
-	return true;
+	G_LOCK(ap_table);
+
+	slot = __libnet_lookup_ap_slot(ap_h);
+	if (slot == NULL) {
+		G_UNLOCK(ap_table);
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (slot->editing == false) {
+		G_UNLOCK(ap_table);
+		WIFI_LOG(WIFI_ERROR, "Error!! Not editing\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	dirty = slot->dirty;
+	slot->editing = false;
+	slot->dirty = false;
+
+	if (dirty && _wifi_libnet_check_profile_name_validity(slot->ap_info->ProfileName)) {
+		memcpy(ap_info, slot->ap_info, sizeof(net_profile_info_t));
+		*send = true;
+	}
+
+	G_UNLOCK(ap_table);
+
+	return WIFI_ERROR_NONE;
 }
 
-int _wifi_activate(void)
+int _wifi_libnet_commit_edit(wifi_ap_h ap_h)
 {
+	net_profile_info_t ap_info;
+	bool send;
 	int rv;
 
-	rv = net_wifi_power_on();
-	if (rv == NET_ERR_NONE)
-		return WIFI_ERROR_NONE;
-	else if (rv == NET_ERR_INVALID_OPERATION)
-		return WIFI_ERROR_INVALID_OPERATION;
+	rv = __libnet_end_edit(ap_h, &ap_info, &send);
+	if (rv != WIFI_ERROR_NONE || send == false)
+		return rv;
 
-	return WIFI_ERROR_OPERATION_FAILED;
+	return _wifi_update_ap_info(&ap_info);
 }
 
-int _wifi_deactivate(void)
+static gboolean __libnet_complete_profile_request(gpointer user_data)
+{
+	struct _profile_request_s *request = user_data;
+
+	if (request->callback)
+		request->callback(request->result, request->user_data);
+
+	return FALSE;
+}
+
+static void __libnet_free_profile_request(gpointer user_data)
+{
+	struct _profile_request_s *request = user_data;
+
+	g_main_context_unref(request->context);
+	g_free(request);
+}
+
+static void __libnet_run_profile_request(gpointer data, gpointer user_data)
+{
+	struct _profile_request_s *request = data;
+	GSource *source;
+
+	if (request->send)
+		request->result = _wifi_update_ap_info(&request->ap_info);
+
+	source = g_idle_source_new();
+	g_source_set_callback(source, __libnet_complete_profile_request, request,
+			__libnet_free_profile_request);
+	__libnet_attach_source(source, request->context);
+	g_source_unref(source);
+}
+
+/* One thread runs the requests in the order they were queued, so changes
+ * to an AP reach the daemon in the order they were committed */
+int _wifi_libnet_commit_edit_async(wifi_ap_h ap_h, wifi_ap_committed_cb callback, void *user_data)
 {
+	struct _profile_request_s *request;
+	gboolean queued = FALSE;
 	int rv;
 
-	rv = net_wifi_power_off();
-	if (rv == NET_ERR_NONE)
-		return WIFI_ERROR_NONE;
-	else if (rv == NET_ERR_INVALID_OPERATION)
-		return WIFI_ERROR_INVALID_OPERATION;
+	request = g_try_new0(struct _profile_request_s, 1);
+	if (request == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
-	return WIFI_ERROR_OPERATION_FAILED;
+	rv = __libnet_end_edit(ap_h, &request->ap_info, &request->send);
+	if (rv != WIFI_ERROR_NONE) {
+		g_free(request);
+		return rv;
+	}
+
+	request->result = WIFI_ERROR_NONE;
+	request->callback = callback;
+	request->user_data = user_data;
+	request->context = __libnet_ref_caller_context();
+
+	G_LOCK(profile_request);
+	if (profile_request_pool == NULL)
+		profile_request_pool = g_thread_pool_new(__libnet_run_profile_request,
+				NULL, 1, FALSE, NULL);
+	if (profile_request_pool)
+		queued = g_thread_pool_push(profile_request_pool, request, NULL);
+	G_UNLOCK(profile_request);
+
+	if (queued == FALSE) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't queue the profile request\n");
+		__libnet_free_profile_request(request);
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	return WIFI_ERROR_NONE;
 }
 
-bool _wifi_libnet_check_ap_validity(wifi_ap_h ap_h)
+net_profile_info_t *_wifi_libnet_alloc_ap_info(void)
 {
-	GSList *list;
-	int i = 0;
+	net_profile_info_t *ap_info;
 
-	for (list = ap_handle_list; list; list = list->next)
-		if (ap_h == list->data) return true;
+	G_LOCK(ap_table);
+	ap_info = __libnet_get_pooled_ap_info();
+	G_UNLOCK(ap_table);
 
-	for (;i < profile_iterator.count;i++)
-		if (ap_h == &profile_iterator.profiles[i]) return true;
+	return ap_info;
+}
 
-	return false;
+void _wifi_libnet_free_ap_info(net_profile_info_t *ap_info)
+{
+	G_LOCK(ap_table);
+	__libnet_put_pooled_ap_info(ap_info);
+	G_UNLOCK(ap_table);
 }
 
-void _wifi_libnet_add_to_ap_list(wifi_ap_h ap_h)
+void _wifi_libnet_get_event_latency_stats(wifi_event_latency_stats_s *stats)
 {
-	ap_handle_list = g_slist_append(ap_handle_list, ap_h);
+	G_LOCK(event_latency);
+	stats->count = event_latency.count;
+	stats->deferred_count = event_latency.deferred;
+	stats->average_us = event_latency.count ?
+			(unsigned int)(event_latency.total_us / event_latency.count) : 0;
+	stats->max_us = (unsigned int)event_latency.max_us;
+	G_UNLOCK(event_latency);
 }
 
-void _wifi_libnet_remove_from_ap_list(wifi_ap_h ap_h)
+void _wifi_libnet_reset_event_latency_stats(void)
+{
+	G_LOCK(event_latency);
+	memset(&event_latency, 0, sizeof(struct _event_latency_s));
+	G_UNLOCK(event_latency);
+}
+
+void _wifi_libnet_set_state_event_window(int window_ms)
+{
+	g_atomic_int_set(&state_event_window, window_ms);
+}
+
+void _wifi_libnet_get_state_event_stats(wifi_state_event_stats_s *stats)
+{
+	G_LOCK(state_event);
+	memcpy(stats, &state_event_stats, sizeof(wifi_state_event_stats_s));
+	G_UNLOCK(state_event);
+}
+
+void _wifi_libnet_set_ap_pool_size(int size)
+{
+	G_LOCK(ap_table);
+	ap_pool.max_size = size;
+	__libnet_shrink_ap_pool(size);
+	G_UNLOCK(ap_table);
+}
+
+void _wifi_libnet_get_ap_pool_stats(wifi_ap_pool_stats_s *stats)
 {
-	ap_handle_list = g_slist_remove(ap_handle_list, ap_h);
-	g_free(ap_h);
+	G_LOCK(ap_table);
+	stats->pool_size = ap_pool.max_size;
+	stats->free_count = ap_pool.free_count;
+	stats->in_use = ap_pool.in_use;
+	stats->high_water_mark = ap_pool.high_water_mark;
+	stats->hits = ap_pool.hits;
+	stats->misses = ap_pool.misses;
+	G_UNLOCK(ap_table);
 }
 
 bool _wifi_libnet_check_profile_name_validity(const char *profile_name)
@@ -431,7 +2991,7 @@ bool _wifi_libnet_check_profile_name_validity(const char *profile_name)
 		return false;
 	}
 
-	return NET_ERR_NONE;
+	return true;
 }
 
 bool _wifi_libnet_get_wifi_state(wifi_connection_state_e* connection_state)
@@ -468,19 +3028,25 @@ bool _wifi_libnet_get_wifi_state(wifi_connection_state_e* connection_state)
 
 int _wifi_libnet_get_intf_name(char** name)
 {
-	if (profile_iterator.count == 0)
-		__libnet_update_profile_iterator();
+	int rv = WIFI_ERROR_NONE;
 
-	if (profile_iterator.count == 0) {
-		WIFI_LOG(WIFI_ERROR, "Error!! There is no AP\n");
-		return WIFI_ERROR_OPERATION_FAILED;
+	G_LOCK(intf_name);
+
+	if (cached_intf_name == NULL)
+		cached_intf_name = __libnet_find_intf_name();
+
+	if (cached_intf_name == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Error!! There is no Wi-Fi interface\n");
+		rv = WIFI_ERROR_OPERATION_FAILED;
+	} else {
+		*name = g_strdup(cached_intf_name);
+		if (*name == NULL)
+			rv = WIFI_ERROR_OUT_OF_MEMORY;
 	}
 
-	*name = g_strdup(profile_iterator.profiles->ProfileInfo.Wlan.net_info.DevName);
-	if (*name == NULL)
-		return WIFI_ERROR_OUT_OF_MEMORY;
+	G_UNLOCK(intf_name);
 
-	return WIFI_ERROR_NONE;
+	return rv;
 }
 
 int _wifi_libnet_scan_request(wifi_scan_finished_cb callback, void* user_data)
@@ -501,57 +3067,426 @@ int _wifi_libnet_scan_request(wifi_scan_finished_cb callback, void* user_data)
 int _wifi_libnet_get_connected_profile(wifi_ap_h *ap)
 {
 	int i = 0;
-	wifi_ap_h ap_h = NULL;
-
-	__libnet_update_profile_iterator();
-
-	for (;i < profile_iterator.count;i++) {
-		if (profile_iterator.profiles[i].ProfileState == NET_STATE_TYPE_ONLINE ||
-		    profile_iterator.profiles[i].ProfileState == NET_STATE_TYPE_READY) {
-			ap_h = (wifi_ap_h)(&profile_iterator.profiles[i]);
-			break;
+	int rv = WIFI_ERROR_NO_CONNECTION;
+	int state;
+	gint epoch;
+	struct _profile_list_s *profile_list;
+
+	G_LOCK(ap_table);
+	state = connected_ap.state;
+	if (state == WIFI_CONNECTED_AP_KNOWN)
+		*ap = __libnet_alloc_ap_slot(connected_ap.ap_info, false, connected_ap.snapshot);
+	G_UNLOCK(ap_table);
+
+	if (state == WIFI_CONNECTED_AP_KNOWN)
+		return *ap ? WIFI_ERROR_NONE : WIFI_ERROR_OUT_OF_MEMORY;
+
+	if (state == WIFI_CONNECTED_AP_UNKNOWN) {
+		/* A cached list was never connected, fetch the live one */
+		if (g_atomic_int_get(&profile_list_is_stale))
+			__libnet_invalidate_profile_list();
+
+		profile_list = __libnet_begin_profile_list_read(&epoch);
+
+		for (;profile_list && i < profile_list->count;i++) {
+			if (__libnet_is_profile_connected(&profile_list->profiles[i])) {
+				rv = __libnet_retain_profile(profile_list, &profile_list->profiles[i], ap);
+				break;
+			}
 		}
+
+		__libnet_end_profile_list_read(epoch);
 	}
 
-	if (ap_h == NULL) {
+	if (rv == WIFI_ERROR_NO_CONNECTION)
 		WIFI_LOG(WIFI_ERROR, "Error!! There is no connected AP.\n");
-		return WIFI_ERROR_NO_CONNECTION;
+
+	return rv;
+}
+
+int _wifi_libnet_get_ap_by_bssid(const char *bssid, wifi_ap_h *ap)
+{
+	struct _profile_list_s *profile_list;
+	struct _profile_index_s *index;
+	net_profile_info_t *profile_info = NULL;
+	int rv = WIFI_ERROR_AP_NOT_FOUND;
+	gint epoch;
+	guint64 key;
+
+	if (__libnet_parse_bssid(bssid, &key) == false)
+		return WIFI_ERROR_INVALID_PARAMETER;
+
+	profile_list = __libnet_begin_profile_list_read(&epoch);
+	if (profile_list) {
+		index = __libnet_get_profile_index(profile_list);
+		if (index == NULL)
+			rv = WIFI_ERROR_OUT_OF_MEMORY;
+		else
+			profile_info = __libnet_lookup_profile(profile_list, index->bssid_index, &key);
+
+		if (profile_info)
+			rv = __libnet_retain_profile(profile_list, profile_info, ap);
 	}
 
-	*ap = g_try_malloc0(sizeof(net_profile_info_t));
-	if (*ap == NULL)
-		return WIFI_ERROR_OUT_OF_MEMORY;
+	__libnet_end_profile_list_read(epoch);
+
+	return rv;
+}
 
-	memcpy(*ap, ap_h, sizeof(net_profile_info_t));
+int _wifi_libnet_get_ap_by_profile_name(const char *profile_name, wifi_ap_h *ap)
+{
+	struct _profile_list_s *profile_list;
+	struct _profile_index_s *index;
+	net_profile_info_t *profile_info = NULL;
+	int rv = WIFI_ERROR_AP_NOT_FOUND;
+	gint epoch;
+
+	profile_list = __libnet_begin_profile_list_read(&epoch);
+	if (profile_list) {
+		index = __libnet_get_profile_index(profile_list);
+		if (index == NULL)
+			rv = WIFI_ERROR_OUT_OF_MEMORY;
+		else
+			profile_info = __libnet_lookup_profile(profile_list, index->name_index, profile_name);
 
-	_wifi_libnet_add_to_ap_list(*ap);
+		if (profile_info)
+			rv = __libnet_retain_profile(profile_list, profile_info, ap);
+	}
 
-	return WIFI_ERROR_NONE;
+	__libnet_end_profile_list_read(epoch);
+
+	return rv;
+}
+
+/* Several APs can share the ESSID, the one with the strongest signal is returned */
+/* Every match is retained under one ap_table lock, in the order of the list */
+int _wifi_libnet_get_ap_by_essid(const char *essid, wifi_ap_h **aps, int *count)
+{
+	struct _profile_list_s *profile_list;
+	struct _profile_index_s *index;
+	GSList *matches = NULL;
+	int rv = WIFI_ERROR_AP_NOT_FOUND;
+	int position;
+	gint epoch;
+
+	*aps = NULL;
+	*count = 0;
+
+	profile_list = __libnet_begin_profile_list_read(&epoch);
+	if (profile_list) {
+		index = __libnet_get_profile_index(profile_list);
+		if (index == NULL)
+			rv = WIFI_ERROR_OUT_OF_MEMORY;
+		else
+			matches = g_hash_table_lookup(index->essid_index, essid);
+	}
+
+	if (matches) {
+		*aps = g_try_new(wifi_ap_h, g_slist_length(matches));
+		if (*aps == NULL)
+			rv = WIFI_ERROR_OUT_OF_MEMORY;
+	}
+
+	if (*aps) {
+		rv = WIFI_ERROR_NONE;
+
+		G_LOCK(ap_table);
+		for (; matches && rv == WIFI_ERROR_NONE; matches = matches->next) {
+			position = GPOINTER_TO_INT(matches->data) - 1;
+			if (position >= profile_list->count)
+				continue;
+
+			(*aps)[*count] = __libnet_alloc_ap_slot(&profile_list->profiles[position],
+					false, profile_list->snapshot);
+			if ((*aps)[*count] == NULL)
+				rv = WIFI_ERROR_OUT_OF_MEMORY;
+			else
+				(*count)++;
+		}
+
+		if (rv != WIFI_ERROR_NONE) {
+			while (*count > 0)
+				__libnet_release_ap_slot((*aps)[--(*count)]);
+		}
+		G_UNLOCK(ap_table);
+
+		if (rv == WIFI_ERROR_NONE && *count == 0)
+			rv = WIFI_ERROR_AP_NOT_FOUND;
+
+		if (rv != WIFI_ERROR_NONE) {
+			g_free(*aps);
+			*aps = NULL;
+		}
+	}
+
+	__libnet_end_profile_list_read(epoch);
+
+	return rv;
 }
 
 bool _wifi_libnet_foreach_found_aps(wifi_found_ap_cb callback, void *user_data)
 {
 	int i = 0;
 	bool rv = true;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	if (profile_list == NULL || profile_list->count == 0) {
+		WIFI_LOG(WIFI_INFO, "There is no APs.\n");
+		__libnet_end_profile_list_read(epoch);
+		return true;
+	}
+
+	for (;i < profile_list->count;i++) {
+		rv = callback(profile_list->handles[i], user_data);
+		if (rv == false) break;
+	}
 
-	__libnet_update_profile_iterator();
+	__libnet_end_profile_list_read(epoch);
 
-	if (profile_iterator.count == 0) {
+	return true;
+}
+
+bool _wifi_libnet_foreach_found_aps_sorted(wifi_ap_sort_key_e key, int max_count,
+		wifi_found_ap_cb callback, void *user_data)
+{
+	struct _profile_order_s *order;
+	int i = 0;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	if (profile_list == NULL || profile_list->count == 0) {
 		WIFI_LOG(WIFI_INFO, "There is no APs.\n");
+		__libnet_end_profile_list_read(epoch);
 		return true;
 	}
 
-	for (;i < profile_iterator.count;i++) {
-		rv = callback((wifi_ap_h)(&profile_iterator.profiles[i]), user_data);
+	order = __libnet_get_profile_order(profile_list, key, max_count);
+	if (order == NULL) {
+		__libnet_end_profile_list_read(epoch);
+		return false;
+	}
+
+	if (max_count <= 0 || max_count > order->count)
+		max_count = order->count;
+
+	for (;i < max_count;i++) {
+		if (callback(profile_list->handles[order->positions[i]], user_data) == false)
+			break;
+	}
+
+	__libnet_end_profile_list_read(epoch);
+
+	return true;
+}
+
+bool _wifi_libnet_foreach_found_aps_filtered(const wifi_ap_filter_s *filter,
+		wifi_found_ap_cb callback, void *user_data)
+{
+	int i = 0;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	for (;profile_list && i < profile_list->count;i++) {
+		if (__libnet_match_profile_filter(&profile_list->summary, i, filter) == false)
+			continue;
+
+		if (callback(profile_list->handles[i], user_data) == false)
+			break;
+	}
+
+	__libnet_end_profile_list_read(epoch);
+
+	return true;
+}
+
+/* For the test program: filters synthetic profiles and picks the strongest
+ * match, once through the fields of net_profile_info_t and once through the
+ * summary. Returns false if the passes disagree or memory is short. */
+bool _wifi_libnet_benchmark_profile_summary(int count, int iterations,
+		long long *profile_us, long long *summary_us)
+{
+	struct _profile_list_s profile_list;
+	net_profile_info_t *profile_info;
+	wifi_ap_filter_s filter;
+	guint32 seed = 1;
+	gint64 start;
+	int security_type;
+	int matches[2] = {0, 0};
+	int best[2] = {-1, -1};
+	int i, j;
+
+	memset(&profile_list, 0, sizeof(struct _profile_list_s));
+	profile_list.count = count;
+	profile_list.profiles = g_try_new0(net_profile_info_t, count);
+	if (profile_list.profiles == NULL)
+		return false;
+
+	for (i = 0; i < count; i++) {
+		profile_info = &profile_list.profiles[i];
+		seed = seed * 1103515245 + 12345;
+
+		profile_info->ProfileInfo.Wlan.Strength = (seed >> 8) % 101;
+		profile_info->ProfileInfo.Wlan.frequency = (seed & 0x10000) ? 5180 : 2412;
+		profile_info->ProfileInfo.Wlan.max_rate = (seed >> 4) % 866;
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode =
+				(seed >> 20) % (WLAN_SEC_MODE_WPA2_PSK + 1);
+		profile_info->Favourite = (seed >> 24) & 1;
+	}
+
+	if (__libnet_build_profile_summary(&profile_list) == false) {
+		g_free(profile_list.profiles);
+		return false;
+	}
+
+	memset(&filter, 0, sizeof(wifi_ap_filter_s));
+	filter.flags = WIFI_AP_FILTER_FREQUENCY | WIFI_AP_FILTER_SECURITY_TYPE | WIFI_AP_FILTER_RSSI;
+	filter.min_frequency = 4900;
+	filter.max_frequency = 5900;
+	filter.security_types = ~(1u << WIFI_SECURITY_TYPE_NONE);
+	filter.min_rssi = 30;
+
+	start = g_get_monotonic_time();
+	for (j = 0; j < iterations; j++) {
+		matches[0] = 0;
+		best[0] = -1;
+		for (i = 0; i < count; i++) {
+			profile_info = &profile_list.profiles[i];
+			if ((int)profile_info->ProfileInfo.Wlan.Strength < filter.min_rssi ||
+			    (int)profile_info->ProfileInfo.Wlan.frequency < filter.min_frequency ||
+			    (int)profile_info->ProfileInfo.Wlan.frequency > filter.max_frequency)
+				continue;
+
+			security_type = __libnet_get_security_type(
+					profile_info->ProfileInfo.Wlan.security_info.sec_mode);
+			if (security_type < 0 || (filter.security_types & (1u << security_type)) == 0)
+				continue;
+
+			matches[0]++;
+			if (best[0] < 0 || profile_info->ProfileInfo.Wlan.Strength >
+					profile_list.profiles[best[0]].ProfileInfo.Wlan.Strength)
+				best[0] = i;
+		}
+	}
+	*profile_us = g_get_monotonic_time() - start;
+
+	start = g_get_monotonic_time();
+	for (j = 0; j < iterations; j++) {
+		matches[1] = 0;
+		best[1] = -1;
+		for (i = 0; i < count; i++) {
+			if (__libnet_match_profile_filter(&profile_list.summary, i, &filter) == false)
+				continue;
+
+			matches[1]++;
+			if (best[1] < 0 || profile_list.summary.rssi[i] > profile_list.summary.rssi[best[1]])
+				best[1] = i;
+		}
+	}
+	*summary_us = g_get_monotonic_time() - start;
+
+	__libnet_clear_profile_summary(&profile_list.summary);
+	g_free(profile_list.profiles);
+
+	return matches[0] == matches[1] && best[0] == best[1];
+}
+
+bool _wifi_libnet_foreach_changed_aps(wifi_changed_ap_cb callback, void *user_data)
+{
+	int i = 0;
+	bool rv = true;
+	wifi_ap_h ap_h;
+	struct _profile_change_s *change;
+	struct _profile_snapshot_s *snapshot;
+	struct _profile_diff_s *diff = NULL;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	if (profile_list && profile_list->diff) {
+		diff = profile_list->diff;
+		g_atomic_int_inc(&diff->ref_count);
+	}
+
+	__libnet_end_profile_list_read(epoch);
+
+	if (diff == NULL)
+		return true;
+
+	for (;i < diff->count;i++) {
+		change = &diff->changes[i];
+		snapshot = change->type == WIFI_AP_CHANGE_TYPE_REMOVED ? diff->prev : diff->next;
+
+		G_LOCK(ap_table);
+		ap_h = __libnet_alloc_ap_slot(&snapshot->profiles[change->index], false, snapshot);
+		G_UNLOCK(ap_table);
+
+		if (ap_h == NULL) {
+			__libnet_unref_profile_diff(diff);
+			return false;
+		}
+
+		rv = callback(ap_h, change->type, change->changed_fields, user_data);
+
+		G_LOCK(ap_table);
+		__libnet_release_ap_slot(ap_h);
+		G_UNLOCK(ap_table);
+
 		if (rv == false) break;
 	}
 
+	__libnet_unref_profile_diff(diff);
+
 	return true;
 }
 
+int _wifi_libnet_export_found_aps(wifi_ap_info_s *buf, int size, int *count)
+{
+	int i = 0;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	*count = profile_list ? profile_list->count : 0;
+
+	for (;i < *count && i < size;i++)
+		_wifi_fill_ap_info(&profile_list->profiles[i], &buf[i], WIFI_AP_FIELD_ALL);
+
+	__libnet_end_profile_list_read(epoch);
+
+	return WIFI_ERROR_NONE;
+}
+
+int _wifi_libnet_export_found_aps_alloc(wifi_ap_info_s **buf, int *count)
+{
+	int rv;
+	gint epoch;
+	struct _profile_list_s *profile_list = __libnet_begin_profile_list_read(&epoch);
+
+	rv = __libnet_copy_profile_list(profile_list, buf, count);
+
+	__libnet_end_profile_list_read(epoch);
+
+	return rv;
+}
+
+void _wifi_libnet_set_scan_cache_path(const char *path)
+{
+	G_LOCK(scan_cache);
+	g_free(scan_cache_path);
+	scan_cache_path = g_strdup(path);
+	G_UNLOCK(scan_cache);
+
+	/* Store the next live list even if no scan event comes first */
+	g_atomic_int_set(&scan_cache_dirty, path != NULL);
+}
+
+bool _wifi_libnet_is_scan_result_stale(void)
+{
+	return g_atomic_int_get(&profile_list_is_stale) ? true : false;
+}
+
 int _wifi_libnet_open_profile(wifi_ap_h ap_h)
 {
-	net_profile_info_t *ap_info = ap_h;
+	net_profile_info_t *ap_info = _wifi_libnet_get_ap_info(ap_h);
 
 	if (ap_info->ProfileInfo.Wlan.security_info.sec_mode == WLAN_SEC_MODE_IEEE8021X)
 		return __libnet_connect_with_wifi_info(ap_info);
@@ -565,7 +3500,7 @@ int _wifi_libnet_open_profile(wifi_ap_h ap_h)
 
 int _wifi_libnet_close_profile(wifi_ap_h ap_h)
 {
-	net_profile_info_t *ap_info = ap_h;
+	net_profile_info_t *ap_info = _wifi_libnet_get_ap_info(ap_h);
 
 	if (net_close_connection(ap_info->ProfileName) != NET_ERR_NONE)
 		return WIFI_ERROR_OPERATION_FAILED;
@@ -575,7 +3510,7 @@ int _wifi_libnet_close_profile(wifi_ap_h ap_h)
 
 int _wifi_libnet_connect_with_wps(wifi_ap_h ap_h, wifi_wps_type_e type, const char *pin)
 {
-	net_profile_info_t *ap_info = ap_h;
+	net_profile_info_t *ap_info = _wifi_libnet_get_ap_info(ap_h);
 	net_wifi_wps_info_t wps_info;
 	memset(&wps_info, 0 , sizeof(net_wifi_wps_info_t));
 
@@ -591,6 +3526,55 @@ int _wifi_libnet_connect_with_wps(wifi_ap_h ap_h, wifi_wps_type_e type, const ch
 	return WIFI_ERROR_NONE;
 }
 
+/* The request is registered before the call, so its response can't be missed */
+static int __libnet_start_request(wifi_ap_h ap_h, net_event_t event, wifi_wps_type_e type,
+		const char *pin, wifi_request_completed_cb callback, void *user_data, int *request_id)
+{
+	int rv;
+	int id = __libnet_add_request(event, _wifi_libnet_get_ap_info(ap_h), callback, user_data);
+
+	if (id == 0)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
+	if (event == NET_EVENT_OPEN_RSP)
+		rv = _wifi_libnet_open_profile(ap_h);
+	else if (event == NET_EVENT_CLOSE_RSP)
+		rv = _wifi_libnet_close_profile(ap_h);
+	else
+		rv = _wifi_libnet_connect_with_wps(ap_h, type, pin);
+
+	if (rv != WIFI_ERROR_NONE) {
+		__libnet_remove_request(id);
+		return rv;
+	}
+
+	if (request_id)
+		*request_id = id;
+
+	return WIFI_ERROR_NONE;
+}
+
+int _wifi_libnet_open_profile_async(wifi_ap_h ap_h, wifi_request_completed_cb callback,
+		void *user_data, int *request_id)
+{
+	return __libnet_start_request(ap_h, NET_EVENT_OPEN_RSP, WIFI_WPS_TYPE_PBC, NULL,
+			callback, user_data, request_id);
+}
+
+int _wifi_libnet_close_profile_async(wifi_ap_h ap_h, wifi_request_completed_cb callback,
+		void *user_data, int *request_id)
+{
+	return __libnet_start_request(ap_h, NET_EVENT_CLOSE_RSP, WIFI_WPS_TYPE_PBC, NULL,
+			callback, user_data, request_id);
+}
+
+int _wifi_libnet_connect_with_wps_async(wifi_ap_h ap_h, wifi_wps_type_e type, const char *pin,
+		wifi_request_completed_cb callback, void *user_data, int *request_id)
+{
+	return __libnet_start_request(ap_h, NET_EVENT_WIFI_WPS_RSP, type, pin,
+			callback, user_data, request_id);
+}
+
 int _wifi_set_power_on_off_cb(wifi_device_state_changed_cb callback, void *user_data)
 {
 	if (wifi_callbacks.device_state_cb)
@@ -48,6 +48,55 @@ int wifi_initialize(void)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_initialize_with_event_thread(void* callback_context)
+{
+	if (is_init) {
+		WIFI_LOG(WIFI_ERROR, "Already initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	if (_wifi_libnet_init_with_event_thread(callback_context) == false) {
+		WIFI_LOG(WIFI_ERROR, "Init failed!\n");
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	is_init = true;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_initialize_with_event_fd(int* fd)
+{
+	if (fd == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (is_init) {
+		WIFI_LOG(WIFI_ERROR, "Already initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	if (_wifi_libnet_init_with_event_fd(fd) == false) {
+		WIFI_LOG(WIFI_ERROR, "Init failed!\n");
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	is_init = true;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_dispatch_pending(void)
+{
+	if (is_init == false) {
+		WIFI_LOG(WIFI_ERROR, "Not initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	return _wifi_libnet_dispatch_pending();
+}
+
 int wifi_deinitialize(void)
 {
 	if (is_init == false) {
@@ -212,6 +261,125 @@ int wifi_foreach_found_aps(wifi_found_ap_cb callback, void* user_data)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_foreach_found_aps_sorted(wifi_ap_sort_key_e key, int max_count, wifi_found_ap_cb callback, void* user_data)
+{
+	if (callback == NULL ||
+	    (key != WIFI_AP_SORT_KEY_RSSI &&
+	     key != WIFI_AP_SORT_KEY_FREQUENCY &&
+	     key != WIFI_AP_SORT_KEY_MAX_SPEED &&
+	     key != WIFI_AP_SORT_KEY_ESSID)) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (_wifi_libnet_foreach_found_aps_sorted(key, max_count, callback, user_data) == false)
+		return WIFI_ERROR_OPERATION_FAILED;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_foreach_found_aps_filtered(const wifi_ap_filter_s* filter, wifi_found_ap_cb callback, void* user_data)
+{
+	if (filter == NULL || callback == NULL ||
+	    ((filter->flags & WIFI_AP_FILTER_FREQUENCY) &&
+	     filter->min_frequency > filter->max_frequency)) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (_wifi_libnet_foreach_found_aps_filtered(filter, callback, user_data) == false)
+		return WIFI_ERROR_OPERATION_FAILED;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_scan_export(wifi_ap_info_s* buf, int size, int* count)
+{
+	if ((buf == NULL && size > 0) || size < 0 || count == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_export_found_aps(buf, size, count);
+}
+
+int wifi_scan_export_alloc(wifi_ap_info_s** buf, int* count)
+{
+	if (buf == NULL || count == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_export_found_aps_alloc(buf, count);
+}
+
+int wifi_set_scan_cache_path(const char* path)
+{
+	if (path != NULL && path[0] == '\0') {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_set_scan_cache_path(path);
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_is_scan_result_stale(bool* stale)
+{
+	if (stale == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	*stale = _wifi_libnet_is_scan_result_stale();
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_foreach_changed_aps(wifi_changed_ap_cb callback, void* user_data)
+{
+	if (callback == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (_wifi_libnet_foreach_changed_aps(callback, user_data) == false)
+		return WIFI_ERROR_OPERATION_FAILED;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_get_ap_by_bssid(const char* bssid, wifi_ap_h* ap)
+{
+	if (bssid == NULL || ap == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_get_ap_by_bssid(bssid, ap);
+}
+
+int wifi_get_ap_by_essid(const char* essid, wifi_ap_h** aps, int* count)
+{
+	if (essid == NULL || aps == NULL || count == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_get_ap_by_essid(essid, aps, count);
+}
+
+int wifi_get_ap_by_profile_name(const char* profile_name, wifi_ap_h* ap)
+{
+	if (profile_name == NULL || ap == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_get_ap_by_profile_name(profile_name, ap);
+}
+
 int wifi_connect(wifi_ap_h ap)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false) {
@@ -259,6 +427,97 @@ int wifi_connect_with_wps(wifi_ap_h ap, wifi_wps_type_e type, const char* pin)
 	return _wifi_libnet_connect_with_wps(ap, type, pin);
 }
 
+int wifi_connect_async(wifi_ap_h ap, wifi_request_completed_cb callback, void* user_data, int* request_id)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || callback == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (is_init == false) {
+		WIFI_LOG(WIFI_ERROR, "Not initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	return _wifi_libnet_open_profile_async(ap, callback, user_data, request_id);
+}
+
+int wifi_disconnect_async(wifi_ap_h ap, wifi_request_completed_cb callback, void* user_data, int* request_id)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || callback == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (is_init == false) {
+		WIFI_LOG(WIFI_ERROR, "Not initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	return _wifi_libnet_close_profile_async(ap, callback, user_data, request_id);
+}
+
+int wifi_connect_with_wps_async(wifi_ap_h ap, wifi_wps_type_e type, const char* pin,
+		wifi_request_completed_cb callback, void* user_data, int* request_id)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || callback == NULL ||
+	    (type != WIFI_WPS_TYPE_PBC && type != WIFI_WPS_TYPE_PIN) ||
+	    (type == WIFI_WPS_TYPE_PIN && pin == NULL)) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (is_init == false) {
+		WIFI_LOG(WIFI_ERROR, "Not initialized\n");
+		return WIFI_ERROR_INVALID_OPERATION;
+	}
+
+	return _wifi_libnet_connect_with_wps_async(ap, type, pin, callback, user_data, request_id);
+}
+
+int wifi_get_event_latency_stats(wifi_event_latency_stats_s* stats)
+{
+	if (stats == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_get_event_latency_stats(stats);
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_reset_event_latency_stats(void)
+{
+	_wifi_libnet_reset_event_latency_stats();
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_set_state_event_coalescing(int window_ms)
+{
+	if (window_ms < 0) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_set_state_event_window(window_ms);
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_get_state_event_stats(wifi_state_event_stats_s* stats)
+{
+	if (stats == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_get_state_event_stats(stats);
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_set_device_state_changed_cb(wifi_device_state_changed_cb callback, void* user_data)
 {
 	if (callback == NULL) {
@@ -45,6 +45,236 @@ static void __wifi_init_ap(net_profile_info_t *profile_info, const char *essid)
 	g_strlcpy(profile_info->ProfileInfo.Wlan.essid, essid, NET_WLAN_ESSID_LEN+1);
 }
 
+/* Sends the change to the daemon, unless it is deferred to wifi_ap_commit() */
+static int __ap_update_profile(wifi_ap_h ap, net_profile_info_t *profile_info)
+{
+	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
+		return WIFI_ERROR_NONE;
+
+	if (_wifi_libnet_mark_ap_dirty(ap))
+		return WIFI_ERROR_NONE;
+
+	return _wifi_update_ap_info(profile_info);
+}
+
+static int __ap_get_connection_state(net_profile_info_t *profile_info, wifi_connection_state_e *state)
+{
+	switch (profile_info->ProfileState) {
+	case NET_STATE_TYPE_IDLE:
+	case NET_STATE_TYPE_FAILURE:
+	case NET_STATE_TYPE_DISCONNECT:
+		*state = WIFI_CONNECTION_STATE_DISCONNECTED;
+		break;
+	case NET_STATE_TYPE_ASSOCIATION:
+	case NET_STATE_TYPE_CONFIGURATION:
+		*state = WIFI_CONNECTION_STATE_CONNECTING;
+		break;
+	case NET_STATE_TYPE_READY:
+	case NET_STATE_TYPE_ONLINE:
+		*state = WIFI_CONNECTION_STATE_CONNECTED;
+		break;
+	default:
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	return WIFI_ERROR_NONE;
+}
+
+static int __ap_get_security_type(net_profile_info_t *profile_info, wifi_security_type_e *type)
+{
+	switch (profile_info->ProfileInfo.Wlan.security_info.sec_mode) {
+	case WLAN_SEC_MODE_NONE:
+		*type = WIFI_SECURITY_TYPE_NONE;
+		break;
+	case WLAN_SEC_MODE_WEP:
+		*type = WIFI_SECURITY_TYPE_WEP;
+		break;
+	case WLAN_SEC_MODE_IEEE8021X:
+		*type = WIFI_SECURITY_TYPE_EAP;
+		break;
+	case WLAN_SEC_MODE_WPA_PSK:
+		*type = WIFI_SECURITY_TYPE_WPA_PSK;
+		break;
+	case WLAN_SEC_MODE_WPA2_PSK:
+		*type = WIFI_SECURITY_TYPE_WPA2_PSK;
+		break;
+	default:
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	return WIFI_ERROR_NONE;
+}
+
+static int __ap_get_encryption_type(net_profile_info_t *profile_info, wifi_encryption_type_e *type)
+{
+	switch (profile_info->ProfileInfo.Wlan.security_info.enc_mode) {
+	case WLAN_ENC_MODE_NONE:
+		*type = WIFI_ENCRYPTION_TYPE_NONE;
+		break;
+	case WLAN_ENC_MODE_WEP:
+		*type = WIFI_ENCRYPTION_TYPE_WEP;
+		break;
+	case WLAN_ENC_MODE_TKIP:
+		*type = WIFI_ENCRYPTION_TYPE_TKIP;
+		break;
+	case WLAN_ENC_MODE_AES:
+		*type = WIFI_ENCRYPTION_TYPE_AES;
+		break;
+	case WLAN_ENC_MODE_TKIP_AES_MIXED:
+		*type = WIFI_ENCRYPTION_TYPE_TKIP_AES_MIXED;
+		break;
+	default:
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	return WIFI_ERROR_NONE;
+}
+
+static int __ap_set_security_type(net_profile_info_t *profile_info, wifi_security_type_e type)
+{
+	switch (type) {
+	case WIFI_SECURITY_TYPE_NONE:
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_NONE;
+		break;
+	case WIFI_SECURITY_TYPE_WEP:
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WEP;
+		break;
+	case WIFI_SECURITY_TYPE_EAP:
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_IEEE8021X;
+		break;
+	case WIFI_SECURITY_TYPE_WPA_PSK:
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WPA_PSK;
+		break;
+	case WIFI_SECURITY_TYPE_WPA2_PSK:
+		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WPA2_PSK;
+		break;
+	default:
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return WIFI_ERROR_NONE;
+}
+
+static int __ap_set_encryption_type(net_profile_info_t *profile_info, wifi_encryption_type_e type)
+{
+	switch (type) {
+	case WIFI_ENCRYPTION_TYPE_NONE:
+		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_NONE;
+		break;
+	case WIFI_ENCRYPTION_TYPE_WEP:
+		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_WEP;
+		break;
+	case WIFI_ENCRYPTION_TYPE_TKIP:
+		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_TKIP;
+		break;
+	case WIFI_ENCRYPTION_TYPE_AES:
+		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_AES;
+		break;
+	case WIFI_ENCRYPTION_TYPE_TKIP_AES_MIXED:
+		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_TKIP_AES_MIXED;
+		break;
+	default:
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return WIFI_ERROR_NONE;
+}
+
+void _wifi_fill_ap_info(net_profile_info_t *profile_info, wifi_ap_info_s *info, unsigned int field_mask)
+{
+	net_wifi_profile_info_t *wlan_info = &profile_info->ProfileInfo.Wlan;
+
+	info->fields = 0;
+
+	if (field_mask & WIFI_AP_FIELD_ESSID) {
+		g_strlcpy(info->essid, wlan_info->essid, sizeof(info->essid));
+		info->fields |= WIFI_AP_FIELD_ESSID;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_BSSID) {
+		g_strlcpy(info->bssid, wlan_info->bssid, sizeof(info->bssid));
+		info->fields |= WIFI_AP_FIELD_BSSID;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_RSSI) {
+		info->rssi = (int)wlan_info->Strength;
+		info->fields |= WIFI_AP_FIELD_RSSI;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_FREQUENCY) {
+		info->frequency = (int)wlan_info->frequency;
+		info->fields |= WIFI_AP_FIELD_FREQUENCY;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_MAX_SPEED) {
+		info->max_speed = (int)wlan_info->max_rate;
+		info->fields |= WIFI_AP_FIELD_MAX_SPEED;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_FAVORITE) {
+		info->favorite = profile_info->Favourite ? true : false;
+		info->fields |= WIFI_AP_FIELD_FAVORITE;
+	}
+
+	if ((field_mask & WIFI_AP_FIELD_CONNECTION_STATE) &&
+	    __ap_get_connection_state(profile_info, &info->connection_state) == WIFI_ERROR_NONE)
+		info->fields |= WIFI_AP_FIELD_CONNECTION_STATE;
+
+	if ((field_mask & WIFI_AP_FIELD_SECURITY_TYPE) &&
+	    __ap_get_security_type(profile_info, &info->security_type) == WIFI_ERROR_NONE)
+		info->fields |= WIFI_AP_FIELD_SECURITY_TYPE;
+
+	if ((field_mask & WIFI_AP_FIELD_ENCRYPTION_TYPE) &&
+	    __ap_get_encryption_type(profile_info, &info->encryption_type) == WIFI_ERROR_NONE)
+		info->fields |= WIFI_AP_FIELD_ENCRYPTION_TYPE;
+
+	if (field_mask & WIFI_AP_FIELD_PASSPHRASE_REQUIRED) {
+		info->passphrase_required = wlan_info->PassphraseRequired ? true : false;
+		info->fields |= WIFI_AP_FIELD_PASSPHRASE_REQUIRED;
+	}
+
+	if (field_mask & WIFI_AP_FIELD_WPS_SUPPORTED) {
+		info->wps_supported = wlan_info->security_info.wps_support ? true : false;
+		info->fields |= WIFI_AP_FIELD_WPS_SUPPORTED;
+	}
+}
+
+/* The connection state is not restored, an AP read back from a cache is idle */
+void _wifi_restore_ap_info(const wifi_ap_info_s *info, net_profile_info_t *profile_info)
+{
+	net_wifi_profile_info_t *wlan_info = &profile_info->ProfileInfo.Wlan;
+
+	memset(profile_info, 0, sizeof(net_profile_info_t));
+	__wifi_init_ap(profile_info, info->essid);
+
+	if (info->fields & WIFI_AP_FIELD_BSSID)
+		g_strlcpy(wlan_info->bssid, info->bssid, sizeof(wlan_info->bssid));
+
+	if (info->fields & WIFI_AP_FIELD_RSSI)
+		wlan_info->Strength = (unsigned char)info->rssi;
+
+	if (info->fields & WIFI_AP_FIELD_FREQUENCY)
+		wlan_info->frequency = (unsigned int)info->frequency;
+
+	if (info->fields & WIFI_AP_FIELD_MAX_SPEED)
+		wlan_info->max_rate = (unsigned int)info->max_speed;
+
+	if (info->fields & WIFI_AP_FIELD_FAVORITE)
+		profile_info->Favourite = info->favorite ? 1 : 0;
+
+	if (info->fields & WIFI_AP_FIELD_SECURITY_TYPE)
+		__ap_set_security_type(profile_info, info->security_type);
+
+	if (info->fields & WIFI_AP_FIELD_ENCRYPTION_TYPE)
+		__ap_set_encryption_type(profile_info, info->encryption_type);
+
+	if (info->fields & WIFI_AP_FIELD_PASSPHRASE_REQUIRED)
+		wlan_info->PassphraseRequired = info->passphrase_required ? TRUE : FALSE;
+
+	if (info->fields & WIFI_AP_FIELD_WPS_SUPPORTED)
+		wlan_info->security_info.wps_support = info->wps_supported ? TRUE : FALSE;
+}
+
 /* Wi-Fi AP module ********************************************************************************/
 
 int wifi_ap_create(const char* essid, wifi_ap_h* ap)
@@ -54,14 +284,17 @@ int wifi_ap_create(const char* essid, wifi_ap_h* ap)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *ap_info = g_try_malloc0(sizeof(net_profile_info_t));
+	net_profile_info_t *ap_info = _wifi_libnet_alloc_ap_info();
 	if (ap_info == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
 
 	__wifi_init_ap(ap_info, essid);
 
-	_wifi_libnet_add_to_ap_list((wifi_ap_h)ap_info);
-	*ap = (wifi_ap_h)ap_info;
+	*ap = _wifi_libnet_add_to_ap_list(ap_info);
+	if (*ap == NULL) {
+		_wifi_libnet_free_ap_info(ap_info);
+		return WIFI_ERROR_OUT_OF_MEMORY;
+	}
 
 	return WIFI_ERROR_NONE;
 }
@@ -85,14 +318,47 @@ int wifi_ap_clone(wifi_ap_h* cloned_ap, wifi_ap_h origin)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *ap_info = g_try_malloc0(sizeof(net_profile_info_t));
-	if (ap_info == NULL)
+	*cloned_ap = _wifi_libnet_clone_ap(origin);
+	if (*cloned_ap == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
 
-	memcpy(ap_info, origin, sizeof(net_profile_info_t));
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_ap_pool_set_size(int size)
+{
+	if (size < 0) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_set_ap_pool_size(size);
 
-	_wifi_libnet_add_to_ap_list((wifi_ap_h)ap_info);
-	*cloned_ap = (wifi_ap_h)ap_info;
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_ap_pool_get_stats(wifi_ap_pool_stats_s* stats)
+{
+	if (stats == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_libnet_get_ap_pool_stats(stats);
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_ap_get_info(wifi_ap_h ap, wifi_ap_info_s* info, unsigned int field_mask)
+{
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+
+	if (profile_info == NULL || info == NULL || (field_mask & ~WIFI_AP_FIELD_ALL) != 0) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	_wifi_fill_ap_info(profile_info, info, field_mask);
 
 	return WIFI_ERROR_NONE;
 }
@@ -101,6 +367,36 @@ int wifi_ap_clone(wifi_ap_h* cloned_ap, wifi_ap_h origin)
 
 /* Wi-Fi network information module ***************************************************************/
 
+int wifi_ap_begin_edit(wifi_ap_h ap)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_begin_edit(ap);
+}
+
+int wifi_ap_commit(wifi_ap_h ap)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_commit_edit(ap);
+}
+
+int wifi_ap_commit_async(wifi_ap_h ap, wifi_ap_committed_cb callback, void* user_data)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	return _wifi_libnet_commit_edit_async(ap, callback, user_data);
+}
+
 int wifi_ap_get_essid(wifi_ap_h ap, char** essid)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || essid == NULL) {
@@ -108,7 +404,7 @@ int wifi_ap_get_essid(wifi_ap_h ap, char** essid)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*essid = g_strdup(profile_info->ProfileInfo.Wlan.essid);
 	if (*essid == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -116,6 +412,19 @@ int wifi_ap_get_essid(wifi_ap_h ap, char** essid)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_essid_ref(wifi_ap_h ap, const char** essid)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || essid == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	*essid = profile_info->ProfileInfo.Wlan.essid;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_get_bssid(wifi_ap_h ap, char** bssid)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || bssid == NULL) {
@@ -123,7 +432,7 @@ int wifi_ap_get_bssid(wifi_ap_h ap, char** bssid)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*bssid = g_strdup(profile_info->ProfileInfo.Wlan.bssid);
 	if (*bssid == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -131,6 +440,19 @@ int wifi_ap_get_bssid(wifi_ap_h ap, char** bssid)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_bssid_ref(wifi_ap_h ap, const char** bssid)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || bssid == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	*bssid = profile_info->ProfileInfo.Wlan.bssid;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_get_rssi(wifi_ap_h ap, int* rssi)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || rssi == NULL) {
@@ -138,7 +460,7 @@ int wifi_ap_get_rssi(wifi_ap_h ap, int* rssi)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*rssi = (int)profile_info->ProfileInfo.Wlan.Strength;
 
 	return WIFI_ERROR_NONE;
@@ -151,7 +473,7 @@ int wifi_ap_get_frequency(wifi_ap_h ap, int* frequency)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*frequency = (int)profile_info->ProfileInfo.Wlan.frequency;
 
 	return WIFI_ERROR_NONE;
@@ -164,7 +486,7 @@ int wifi_ap_get_max_speed(wifi_ap_h ap, int* max_speed)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*max_speed = (int)profile_info->ProfileInfo.Wlan.max_rate;
 
 	return WIFI_ERROR_NONE;
@@ -177,7 +499,7 @@ int wifi_ap_is_favorite(wifi_ap_h ap, bool* favorite)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	if (profile_info->Favourite)
 		*favorite = true;
@@ -194,27 +516,9 @@ int wifi_ap_get_connection_state(wifi_ap_h ap, wifi_connection_state_e* state)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
-	switch (profile_info->ProfileState) {
-	case NET_STATE_TYPE_IDLE:
-	case NET_STATE_TYPE_FAILURE:
-	case NET_STATE_TYPE_DISCONNECT:
-		*state = WIFI_CONNECTION_STATE_DISCONNECTED;
-		break;
-	case NET_STATE_TYPE_ASSOCIATION:
-	case NET_STATE_TYPE_CONFIGURATION:
-		*state = WIFI_CONNECTION_STATE_CONNECTING;
-		break;
-	case NET_STATE_TYPE_READY:
-	case NET_STATE_TYPE_ONLINE:
-		*state = WIFI_CONNECTION_STATE_CONNECTED;
-		break;
-	default:
-		return WIFI_ERROR_OPERATION_FAILED;
-	}
-
-	return WIFI_ERROR_NONE;
+	return __ap_get_connection_state(profile_info, state);
 }
 
 int wifi_ap_get_ip_config_type(wifi_ap_h ap, wifi_address_family_e address_family, wifi_ip_config_type_e* type)
@@ -232,7 +536,7 @@ int wifi_ap_get_ip_config_type(wifi_ap_h ap, wifi_address_family_e address_famil
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	switch (profile_info->ProfileInfo.Wlan.net_info.IpConfigType) {
 	case NET_IP_CONFIG_TYPE_STATIC:
@@ -271,7 +575,9 @@ int wifi_ap_set_ip_config_type(wifi_ap_h ap, wifi_address_family_e address_famil
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
 	switch (type) {
 	case WIFI_IP_CONFIG_TYPE_STATIC:
@@ -293,10 +599,7 @@ int wifi_ap_set_ip_config_type(wifi_ap_h ap, wifi_address_family_e address_famil
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_ip_address(wifi_ap_h ap, wifi_address_family_e address_family, char** ip_address)
@@ -314,7 +617,7 @@ int wifi_ap_get_ip_address(wifi_ap_h ap, wifi_address_family_e address_family, c
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*ip_address = __ap_convert_ip_to_string(&profile_info->ProfileInfo.Wlan.net_info.IpAddr);
 	if (*ip_address == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -337,14 +640,14 @@ int wifi_ap_set_ip_address(wifi_ap_h ap, wifi_address_family_e address_family, c
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (inet_aton(ip_address, &(profile_info->ProfileInfo.Wlan.net_info.IpAddr.Data.Ipv4)) == 0)
 		return WIFI_ERROR_INVALID_PARAMETER;
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_subnet_mask(wifi_ap_h ap, wifi_address_family_e address_family, char** subnet_mask)
@@ -362,7 +665,7 @@ int wifi_ap_get_subnet_mask(wifi_ap_h ap, wifi_address_family_e address_family,
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*subnet_mask = __ap_convert_ip_to_string(&profile_info->ProfileInfo.Wlan.net_info.SubnetMask);
 	if (*subnet_mask == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -385,14 +688,14 @@ int wifi_ap_set_subnet_mask(wifi_ap_h ap, wifi_address_family_e address_family,
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (inet_aton(subnet_mask, &(profile_info->ProfileInfo.Wlan.net_info.SubnetMask.Data.Ipv4)) == 0)
 		return WIFI_ERROR_INVALID_PARAMETER;
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_gateway_address(wifi_ap_h ap, wifi_address_family_e address_family, char** gateway_address)
@@ -410,7 +713,7 @@ int wifi_ap_get_gateway_address(wifi_ap_h ap, wifi_address_family_e address_fami
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*gateway_address = __ap_convert_ip_to_string(&profile_info->ProfileInfo.Wlan.net_info.GatewayAddr);
 	if (*gateway_address == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -433,14 +736,14 @@ int wifi_ap_set_gateway_address(wifi_ap_h ap, wifi_address_family_e address_fami
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (inet_aton(gateway_address, &(profile_info->ProfileInfo.Wlan.net_info.GatewayAddr.Data.Ipv4)) == 0)
 		return WIFI_ERROR_INVALID_PARAMETER;
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family, char** proxy_address)
@@ -458,7 +761,7 @@ int wifi_ap_get_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	*proxy_address = g_strdup(profile_info->ProfileInfo.Wlan.net_info.ProxyAddr);
 	if (*proxy_address == NULL)
 		return WIFI_ERROR_OUT_OF_MEMORY;
@@ -466,6 +769,27 @@ int wifi_ap_get_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_proxy_address_ref(wifi_ap_h ap, wifi_address_family_e address_family, const char** proxy_address)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false ||
+	    (address_family != WIFI_ADDRESS_FAMILY_IPV4 &&
+	     address_family != WIFI_ADDRESS_FAMILY_IPV6) ||
+	    proxy_address == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (address_family == WIFI_ADDRESS_FAMILY_IPV6) {
+		WIFI_LOG(WIFI_ERROR, "Not supported yet\n");
+		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	*proxy_address = profile_info->ProfileInfo.Wlan.net_info.ProxyAddr;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_set_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family, const char* proxy_address)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false ||
@@ -481,13 +805,13 @@ int wifi_ap_set_proxy_address(wifi_ap_h ap, wifi_address_family_e address_family
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
-	g_strlcpy(profile_info->ProfileInfo.Wlan.net_info.ProxyAddr, proxy_address, NET_PROXY_LEN_MAX+1);
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
+	g_strlcpy(profile_info->ProfileInfo.Wlan.net_info.ProxyAddr, proxy_address, NET_PROXY_LEN_MAX+1);
 
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_proxy_type(wifi_ap_h ap, wifi_proxy_type_e* type)
@@ -497,7 +821,7 @@ int wifi_ap_get_proxy_type(wifi_ap_h ap, wifi_proxy_type_e* type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	switch (profile_info->ProfileInfo.Wlan.net_info.ProxyMethod) {
 	case NET_PROXY_TYPE_DIRECT:
@@ -524,7 +848,9 @@ int wifi_ap_set_proxy_type(wifi_ap_h ap, wifi_proxy_type_e proxy_type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
 	switch (proxy_type) {
 	case WIFI_PROXY_TYPE_DIRECT:
@@ -540,10 +866,7 @@ int wifi_ap_set_proxy_type(wifi_ap_h ap, wifi_proxy_type_e proxy_type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_get_dns_address(wifi_ap_h ap, int order, wifi_address_family_e address_family, char** dns_address)
@@ -563,7 +886,7 @@ int wifi_ap_get_dns_address(wifi_ap_h ap, int order, wifi_address_family_e addre
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	*dns_address = __ap_convert_ip_to_string(&profile_info->ProfileInfo.Wlan.net_info.DnsAddr[order-1]);
 	if (*dns_address == NULL)
@@ -589,14 +912,14 @@ int wifi_ap_set_dns_address(wifi_ap_h ap, int order, wifi_address_family_e addre
 		return WIFI_ERROR_ADDRESS_FAMILY_NOT_SUPPORTED;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (inet_aton(dns_address, &(profile_info->ProfileInfo.Wlan.net_info.DnsAddr[order-1].Data.Ipv4)) == 0)
 		return WIFI_ERROR_INVALID_PARAMETER;
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 
@@ -610,29 +933,9 @@ int wifi_ap_get_security_type(wifi_ap_h ap, wifi_security_type_e* type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
-	switch (profile_info->ProfileInfo.Wlan.security_info.sec_mode) {
-	case WLAN_SEC_MODE_NONE:
-		*type = WIFI_SECURITY_TYPE_NONE;
-		break;
-	case WLAN_SEC_MODE_WEP:
-		*type = WIFI_SECURITY_TYPE_WEP;
-		break;
-	case WLAN_SEC_MODE_IEEE8021X:
-		*type = WIFI_SECURITY_TYPE_EAP;
-		break;
-	case WLAN_SEC_MODE_WPA_PSK:
-		*type = WIFI_SECURITY_TYPE_WPA_PSK;
-		break;
-	case WLAN_SEC_MODE_WPA2_PSK:
-		*type = WIFI_SECURITY_TYPE_WPA2_PSK;
-		break;
-	default:
-		return WIFI_ERROR_OPERATION_FAILED;
-	}
-
-	return WIFI_ERROR_NONE;
+	return __ap_get_security_type(profile_info, type);
 }
 
 int wifi_ap_set_security_type(wifi_ap_h ap, wifi_security_type_e type)
@@ -642,29 +945,11 @@ int wifi_ap_set_security_type(wifi_ap_h ap, wifi_security_type_e type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
-
-	switch (type) {
-	case WIFI_SECURITY_TYPE_NONE:
-		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_NONE;
-		break;
-	case WIFI_SECURITY_TYPE_WEP:
-		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WEP;
-		break;
-	case WIFI_SECURITY_TYPE_EAP:
-		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_IEEE8021X;
-		break;
-	case WIFI_SECURITY_TYPE_WPA_PSK:
-		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WPA_PSK;
-		break;
-	case WIFI_SECURITY_TYPE_WPA2_PSK:
-		profile_info->ProfileInfo.Wlan.security_info.sec_mode = WLAN_SEC_MODE_WPA2_PSK;
-		break;
-	default:
-		return WIFI_ERROR_INVALID_PARAMETER;
-	}
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
-	return WIFI_ERROR_NONE;
+	return __ap_set_security_type(profile_info, type);
 }
 
 int wifi_ap_get_encryption_type(wifi_ap_h ap, wifi_encryption_type_e* type)
@@ -674,29 +959,9 @@ int wifi_ap_get_encryption_type(wifi_ap_h ap, wifi_encryption_type_e* type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
-	switch (profile_info->ProfileInfo.Wlan.security_info.enc_mode) {
-	case WLAN_ENC_MODE_NONE:
-		*type = WIFI_ENCRYPTION_TYPE_NONE;
-		break;
-	case WLAN_ENC_MODE_WEP:
-		*type = WIFI_ENCRYPTION_TYPE_WEP;
-		break;
-	case WLAN_ENC_MODE_TKIP:
-		*type = WIFI_ENCRYPTION_TYPE_TKIP;
-		break;
-	case WLAN_ENC_MODE_AES:
-		*type = WIFI_ENCRYPTION_TYPE_AES;
-		break;
-	case WLAN_ENC_MODE_TKIP_AES_MIXED:
-		*type = WIFI_ENCRYPTION_TYPE_TKIP_AES_MIXED;
-		break;
-	default:
-		return WIFI_ERROR_OPERATION_FAILED;
-	}
-
-	return WIFI_ERROR_NONE;
+	return __ap_get_encryption_type(profile_info, type);
 }
 
 int wifi_ap_set_encryption_type(wifi_ap_h ap, wifi_encryption_type_e type)
@@ -706,29 +971,11 @@ int wifi_ap_set_encryption_type(wifi_ap_h ap, wifi_encryption_type_e type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
-
-	switch (type) {
-	case WIFI_ENCRYPTION_TYPE_NONE:
-		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_NONE;
-		break;
-	case WIFI_ENCRYPTION_TYPE_WEP:
-		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_WEP;
-		break;
-	case WIFI_ENCRYPTION_TYPE_TKIP:
-		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_TKIP;
-		break;
-	case WIFI_ENCRYPTION_TYPE_AES:
-		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_AES;
-		break;
-	case WIFI_ENCRYPTION_TYPE_TKIP_AES_MIXED:
-		profile_info->ProfileInfo.Wlan.security_info.enc_mode = WLAN_ENC_MODE_TKIP_AES_MIXED;
-		break;
-	default:
-		return WIFI_ERROR_INVALID_PARAMETER;
-	}
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
-	return WIFI_ERROR_NONE;
+	return __ap_set_encryption_type(profile_info, type);
 }
 
 int wifi_ap_is_passphrase_required(wifi_ap_h ap, bool* required)
@@ -738,7 +985,7 @@ int wifi_ap_is_passphrase_required(wifi_ap_h ap, bool* required)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	if (profile_info->ProfileInfo.Wlan.PassphraseRequired)
 		*required = true;
@@ -755,7 +1002,9 @@ int wifi_ap_set_passphrase(wifi_ap_h ap, const char* passphrase)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
 
 	switch (profile_info->ProfileInfo.Wlan.security_info.sec_mode) {
 	case WLAN_SEC_MODE_WEP:
@@ -773,10 +1022,7 @@ int wifi_ap_set_passphrase(wifi_ap_h ap, const char* passphrase)
 		return WIFI_ERROR_OPERATION_FAILED;
 	}
 
-	if (_wifi_libnet_check_profile_name_validity(profile_info->ProfileName) == false)
-		return WIFI_ERROR_NONE;
-
-	return _wifi_update_ap_info(profile_info);
+	return __ap_update_profile(ap, profile_info);
 }
 
 int wifi_ap_is_wps_supported(wifi_ap_h ap, bool* supported)
@@ -786,7 +1032,7 @@ int wifi_ap_is_wps_supported(wifi_ap_h ap, bool* supported)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 
 	if (profile_info->ProfileInfo.Wlan.security_info.wps_support)
 		*supported = true;
@@ -807,7 +1053,10 @@ int wifi_ap_set_eap_passphrase(wifi_ap_h ap, const char* user_name, const char*
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -826,7 +1075,7 @@ int wifi_ap_get_eap_ca_cert_file(wifi_ap_h ap, char** file)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -837,6 +1086,22 @@ int wifi_ap_get_eap_ca_cert_file(wifi_ap_h ap, char** file)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_eap_ca_cert_file_ref(wifi_ap_h ap, const char** file)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	*file = profile_info->ProfileInfo.Wlan.security_info.authentication.eap.ca_cert_filename;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_set_eap_ca_cert_file(wifi_ap_h ap, const char* file)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL) {
@@ -844,7 +1109,10 @@ int wifi_ap_set_eap_ca_cert_file(wifi_ap_h ap, const char* file)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -861,7 +1129,7 @@ int wifi_ap_get_eap_client_cert_file(wifi_ap_h ap, char** file)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -872,6 +1140,22 @@ int wifi_ap_get_eap_client_cert_file(wifi_ap_h ap, char** file)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_eap_client_cert_file_ref(wifi_ap_h ap, const char** file)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	*file = profile_info->ProfileInfo.Wlan.security_info.authentication.eap.client_cert_filename;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_set_eap_client_cert_file(wifi_ap_h ap, const char* file)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL) {
@@ -879,7 +1163,10 @@ int wifi_ap_set_eap_client_cert_file(wifi_ap_h ap, const char* file)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -896,7 +1183,7 @@ int wifi_ap_get_eap_private_key_file(wifi_ap_h ap, char** file)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -907,6 +1194,22 @@ int wifi_ap_get_eap_private_key_file(wifi_ap_h ap, char** file)
 	return WIFI_ERROR_NONE;
 }
 
+int wifi_ap_get_eap_private_key_file_ref(wifi_ap_h ap, const char** file)
+{
+	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
+	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
+		return WIFI_ERROR_INVALID_OPERATION;
+
+	*file = profile_info->ProfileInfo.Wlan.security_info.authentication.eap.private_key_filename;
+
+	return WIFI_ERROR_NONE;
+}
+
 int wifi_ap_set_eap_private_key_info(wifi_ap_h ap, const char* file, const char* password)
 {
 	if (_wifi_libnet_check_ap_validity(ap) == false || file == NULL || password == NULL) {
@@ -914,7 +1217,10 @@ int wifi_ap_set_eap_private_key_info(wifi_ap_h ap, const char* file, const char*
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -933,7 +1239,7 @@ int wifi_ap_get_eap_type(wifi_ap_h ap, wifi_eap_type_e* type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -967,7 +1273,10 @@ int wifi_ap_set_eap_type(wifi_ap_h ap, wifi_eap_type_e type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -1001,7 +1310,7 @@ int wifi_ap_get_eap_auth_type(wifi_ap_h ap, wifi_eap_auth_type_e* type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info(ap);
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -1038,7 +1347,10 @@ int wifi_ap_set_eap_auth_type(wifi_ap_h ap, wifi_eap_auth_type_e type)
 		return WIFI_ERROR_INVALID_PARAMETER;
 	}
 
-	net_profile_info_t *profile_info = ap;
+	net_profile_info_t *profile_info = _wifi_libnet_get_ap_info_for_write(ap);
+	if (profile_info == NULL)
+		return WIFI_ERROR_OUT_OF_MEMORY;
+
 	if (profile_info->ProfileInfo.Wlan.security_info.sec_mode != WLAN_SEC_MODE_IEEE8021X)
 		return WIFI_ERROR_INVALID_OPERATION;
 
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glib.h>
+#include "net_wifi_private.h"
+
+#define WIFI_SCAN_SNAPSHOT_MAGIC 0x534e4657	/* "WFNS" */
+#define WIFI_SCAN_SNAPSHOT_VERSION 2
+
+/* A snapshot is this header followed by count records of record_size bytes,
+ * in host byte order. A file from a host of the other byte order fails the
+ * magic check. */
+struct _scan_snapshot_header_s {
+	guint32 magic;
+	guint16 version;
+	guint16 header_size;
+	guint32 record_size;
+	guint32 count;
+	gint64 timestamp;
+};
+
+/* Only fixed-width fields, so the layout doesn't depend on the ABI of the
+ * writer. Records are validated when they are copied out. */
+struct _scan_snapshot_record_s {
+	guint32 fields;
+	gint32 rssi;
+	gint32 frequency;
+	gint32 max_speed;
+	guint8 favorite;
+	guint8 connection_state;
+	guint8 security_type;
+	guint8 encryption_type;
+	guint8 passphrase_required;
+	guint8 wps_supported;
+	guint8 reserved[2];
+	char essid[WIFI_AP_INFO_ESSID_LEN + 1];
+	char bssid[WIFI_AP_INFO_BSSID_LEN + 1];
+	guint8 padding[2];
+};
+
+struct _scan_snapshot_s {
+	void *map;
+	size_t size;
+	const struct _scan_snapshot_header_s *header;
+	const struct _scan_snapshot_record_s *records;
+};
+
+static bool __snapshot_write_all(int fd, const void *data, size_t size, off_t offset)
+{
+	const char *pos = data;
+	ssize_t written;
+
+	while (size > 0) {
+		written = pwrite(fd, pos, size, offset);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+
+		pos += written;
+		offset += written;
+		size -= written;
+	}
+
+	return true;
+}
+
+static bool __snapshot_check_header(const struct _scan_snapshot_header_s *header, size_t size)
+{
+	if (size < sizeof(struct _scan_snapshot_header_s))
+		return false;
+
+	if (header->magic != WIFI_SCAN_SNAPSHOT_MAGIC ||
+	    header->version != WIFI_SCAN_SNAPSHOT_VERSION ||
+	    header->header_size != sizeof(struct _scan_snapshot_header_s) ||
+	    header->record_size != sizeof(struct _scan_snapshot_record_s))
+		return false;
+
+	if (header->count > (size - header->header_size) / header->record_size)
+		return false;
+
+	return true;
+}
+
+static void __snapshot_pack_record(const wifi_ap_info_s *info, struct _scan_snapshot_record_s *record)
+{
+	memset(record, 0, sizeof(struct _scan_snapshot_record_s));
+	record->fields = info->fields;
+	record->rssi = info->rssi;
+	record->frequency = info->frequency;
+	record->max_speed = info->max_speed;
+	record->favorite = info->favorite;
+	record->connection_state = info->connection_state;
+	record->security_type = info->security_type;
+	record->encryption_type = info->encryption_type;
+	record->passphrase_required = info->passphrase_required;
+	record->wps_supported = info->wps_supported;
+	memcpy(record->essid, info->essid, sizeof(record->essid));
+	memcpy(record->bssid, info->bssid, sizeof(record->bssid));
+}
+
+static bool __snapshot_unpack_record(const struct _scan_snapshot_record_s *record, wifi_ap_info_s *info)
+{
+	if (record->connection_state > WIFI_CONNECTION_STATE_DISCONNECTED ||
+	    record->security_type > WIFI_SECURITY_TYPE_EAP ||
+	    record->encryption_type > WIFI_ENCRYPTION_TYPE_TKIP_AES_MIXED)
+		return false;
+
+	memset(info, 0, sizeof(wifi_ap_info_s));
+	info->fields = record->fields & WIFI_AP_FIELD_ALL;
+	info->rssi = record->rssi;
+	info->frequency = record->frequency;
+	info->max_speed = record->max_speed;
+	info->favorite = record->favorite != 0;
+	info->connection_state = record->connection_state;
+	info->security_type = record->security_type;
+	info->encryption_type = record->encryption_type;
+	info->passphrase_required = record->passphrase_required != 0;
+	info->wps_supported = record->wps_supported != 0;
+	memcpy(info->essid, record->essid, sizeof(info->essid));
+	memcpy(info->bssid, record->bssid, sizeof(info->bssid));
+	info->essid[WIFI_AP_INFO_ESSID_LEN] = '\0';
+	info->bssid[WIFI_AP_INFO_BSSID_LEN] = '\0';
+
+	return true;
+}
+
+static int __snapshot_write_records(int fd, const wifi_ap_info_s *infos, int count)
+{
+	struct _scan_snapshot_header_s header;
+	struct _scan_snapshot_record_s *records = NULL;
+	int rv = WIFI_ERROR_NONE;
+	int i;
+
+	if (count > 0) {
+		records = g_try_new(struct _scan_snapshot_record_s, count);
+		if (records == NULL)
+			return WIFI_ERROR_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < count; i++)
+		__snapshot_pack_record(&infos[i], &records[i]);
+
+	memset(&header, 0, sizeof(struct _scan_snapshot_header_s));
+	header.magic = WIFI_SCAN_SNAPSHOT_MAGIC;
+	header.version = WIFI_SCAN_SNAPSHOT_VERSION;
+	header.header_size = sizeof(struct _scan_snapshot_header_s);
+	header.record_size = sizeof(struct _scan_snapshot_record_s);
+	header.count = count;
+	header.timestamp = g_get_real_time();
+
+	/* The header goes last, so a reader of a new file never sees a count without records */
+	if (ftruncate(fd, header.header_size + (off_t)count * header.record_size) != 0 ||
+	    __snapshot_write_all(fd, records, count * sizeof(struct _scan_snapshot_record_s),
+			header.header_size) == false ||
+	    __snapshot_write_all(fd, &header, header.header_size, 0) == false) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't write the scan snapshot [%d]\n", errno);
+		rv = WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	g_free(records);
+
+	return rv;
+}
+
+/* Replaces the cache with rename(), so a process mapping the old one is not disturbed */
+int _wifi_scan_cache_store(const char *path, const wifi_ap_info_s *records, int count)
+{
+	char *tmp_path = g_strdup_printf("%s.tmp", path);
+	int fd;
+	int rv;
+
+	fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't open %s [%d]\n", tmp_path, errno);
+		g_free(tmp_path);
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	rv = __snapshot_write_records(fd, records, count);
+	close(fd);
+
+	if (rv == WIFI_ERROR_NONE && rename(tmp_path, path) != 0) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Can't replace %s [%d]\n", path, errno);
+		rv = WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	if (rv != WIFI_ERROR_NONE)
+		unlink(tmp_path);
+
+	g_free(tmp_path);
+
+	return rv;
+}
+
+int _wifi_scan_cache_load(const char *path, net_profile_info_t **profiles, int *count)
+{
+	wifi_scan_snapshot_h snapshot = NULL;
+	struct _scan_snapshot_s *snapshot_info;
+	wifi_ap_info_s info;
+	int fd;
+	int rv;
+	int i;
+
+	*profiles = NULL;
+	*count = 0;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return WIFI_ERROR_OPERATION_FAILED;
+
+	rv = wifi_scan_snapshot_open(fd, &snapshot);
+	close(fd);
+	if (rv != WIFI_ERROR_NONE)
+		return rv;
+
+	snapshot_info = snapshot;
+	if (snapshot_info->header->count > 0) {
+		*profiles = g_try_new0(net_profile_info_t, snapshot_info->header->count);
+		if (*profiles == NULL) {
+			wifi_scan_snapshot_close(snapshot);
+			return WIFI_ERROR_OUT_OF_MEMORY;
+		}
+	}
+
+	for (i = 0; i < (int)snapshot_info->header->count; i++) {
+		if (__snapshot_unpack_record(&snapshot_info->records[i], &info) == false)
+			continue;
+
+		_wifi_restore_ap_info(&info, &(*profiles)[*count]);
+		(*count)++;
+	}
+
+	WIFI_LOG(WIFI_INFO, "Scan cache loaded : %d APs, written at %lld\n",
+			*count, (long long)snapshot_info->header->timestamp);
+
+	wifi_scan_snapshot_close(snapshot);
+
+	return WIFI_ERROR_NONE;
+}
+
+/* Wi-Fi scan snapshot module **********************************************************************/
+
+int wifi_scan_snapshot_write(int fd)
+{
+	wifi_ap_info_s *records = NULL;
+	int count = 0;
+	int rv;
+
+	if (fd < 0) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	rv = _wifi_libnet_export_found_aps_alloc(&records, &count);
+	if (rv != WIFI_ERROR_NONE)
+		return rv;
+
+	rv = __snapshot_write_records(fd, records, count);
+
+	g_free(records);
+
+	return rv;
+}
+
+int wifi_scan_snapshot_open(int fd, wifi_scan_snapshot_h* snapshot)
+{
+	struct _scan_snapshot_s *snapshot_info;
+	struct stat st;
+	void *map;
+
+	if (fd < 0 || snapshot == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(struct _scan_snapshot_header_s)) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Not a scan snapshot\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED) {
+		WIFI_LOG(WIFI_ERROR, "Error!! mmap() failed [%d]\n", errno);
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	if (__snapshot_check_header(map, st.st_size) == false) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Not a scan snapshot\n");
+		munmap(map, st.st_size);
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	snapshot_info = g_try_new0(struct _scan_snapshot_s, 1);
+	if (snapshot_info == NULL) {
+		munmap(map, st.st_size);
+		return WIFI_ERROR_OUT_OF_MEMORY;
+	}
+
+	snapshot_info->map = map;
+	snapshot_info->size = st.st_size;
+	snapshot_info->header = map;
+	snapshot_info->records = (const struct _scan_snapshot_record_s *)
+			((const char *)map + snapshot_info->header->header_size);
+
+	*snapshot = snapshot_info;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_scan_snapshot_close(wifi_scan_snapshot_h snapshot)
+{
+	struct _scan_snapshot_s *snapshot_info = snapshot;
+
+	if (snapshot_info == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	munmap(snapshot_info->map, snapshot_info->size);
+	g_free(snapshot_info);
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_scan_snapshot_get_count(wifi_scan_snapshot_h snapshot, int* count)
+{
+	struct _scan_snapshot_s *snapshot_info = snapshot;
+
+	if (snapshot_info == NULL || count == NULL) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	*count = snapshot_info->header->count;
+
+	return WIFI_ERROR_NONE;
+}
+
+int wifi_scan_snapshot_get_ap_info(wifi_scan_snapshot_h snapshot, int index, wifi_ap_info_s* info)
+{
+	struct _scan_snapshot_s *snapshot_info = snapshot;
+
+	if (snapshot_info == NULL || info == NULL ||
+	    index < 0 || index >= (int)snapshot_info->header->count) {
+		WIFI_LOG(WIFI_ERROR, "Wrong Parameter Passed\n");
+		return WIFI_ERROR_INVALID_PARAMETER;
+	}
+
+	if (__snapshot_unpack_record(&snapshot_info->records[index], info) == false) {
+		WIFI_LOG(WIFI_ERROR, "Error!! Corrupt scan snapshot record %d\n", index);
+		return WIFI_ERROR_OPERATION_FAILED;
+	}
+
+	return WIFI_ERROR_NONE;
+}
@@ -30,6 +30,7 @@
 #include "glib.h"
 #include <wifi.h>
 #include <tizen_error.h>
+#include "net_wifi_private.h"
 
 
 gboolean test_thread(GIOChannel *source, GIOCondition condition, gpointer data);
@@ -132,6 +133,56 @@ static bool __test_found_ap_callback(wifi_ap_h ap, void *user_data)
 	return true;
 }
 
+static bool __test_found_ap_ref_callback(wifi_ap_h ap, void *user_data)
+{
+	int rv = 0;
+	const char *ap_name = NULL;
+	const char *bssid = NULL;
+
+	rv = wifi_ap_get_essid_ref(ap, &ap_name);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get AP name [%d]\n", rv);
+		return false;
+	}
+
+	rv = wifi_ap_get_bssid_ref(ap, &bssid);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get BSSID [%d]\n", rv);
+		return false;
+	}
+
+	printf("AP name : %s, BSSID : %s\n", ap_name, bssid);
+
+	return true;
+}
+
+static bool __test_changed_ap_callback(wifi_ap_h ap, wifi_ap_change_type_e type, unsigned int changed_fields, void *user_data)
+{
+	int rv = 0;
+	char *ap_name = NULL;
+
+	rv = wifi_ap_get_essid(ap, &ap_name);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get AP name [%d]\n", rv);
+		return false;
+	}
+
+	switch (type) {
+	case WIFI_AP_CHANGE_TYPE_ADDED:
+		printf("Added AP : %s\n", ap_name);
+		break;
+	case WIFI_AP_CHANGE_TYPE_REMOVED:
+		printf("Removed AP : %s\n", ap_name);
+		break;
+	case WIFI_AP_CHANGE_TYPE_UPDATED:
+		printf("Updated AP : %s, changed fields : 0x%04x\n", ap_name, changed_fields);
+		break;
+	}
+
+	g_free(ap_name);
+	return true;
+}
+
 static bool __test_found_connect_ap_callback(wifi_ap_h ap, void *user_data)
 {
 	int rv = 0;
@@ -219,11 +270,80 @@ int test_wifi_init(void)
 	printf("Wifi init succeeded\n");
 	return 1;
 }
+
+int test_wifi_init_with_event_thread(void)
+{
+	int rv;
+	int in_main_loop = 0;
+
+	printf("Invoke callbacks in main loop? (1:yes, 0:no, in event thread) : ");
+	rv = scanf("%d", &in_main_loop);
+
+	rv = wifi_initialize_with_event_thread(in_main_loop ? g_main_context_default() : NULL);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Wifi init with event thread failed [%d]\n", rv);
+		return -1;
+	}
+
+	wifi_set_device_state_changed_cb(__test_device_state_callback, NULL);
+	wifi_set_background_scan_cb(__test_bg_scan_completed_callback, NULL);
+	wifi_set_connection_state_changed_cb(__test_connection_state_callback, NULL);
+	wifi_set_rssi_level_changed_cb(__test_rssi_level_callback, NULL);
+
+	printf("Wifi init with event thread succeeded\n");
+	return 1;
+}
+
+static guint event_fd_watch = 0;
+
+static gboolean __test_event_fd_callback(GIOChannel *source, GIOCondition condition, gpointer data)
+{
+	int rv = wifi_dispatch_pending();
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to dispatch pending events [%d]\n", rv);
+		event_fd_watch = 0;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+int test_wifi_init_with_event_fd(void)
+{
+	GIOChannel *channel;
+	int fd = -1;
+	int rv = wifi_initialize_with_event_fd(&fd);
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Wifi init with event fd failed [%d]\n", rv);
+		return -1;
+	}
+
+	/* Any poll loop works, the test program happens to run a GLib one */
+	channel = g_io_channel_unix_new(fd);
+	event_fd_watch = g_io_add_watch(channel, G_IO_IN, __test_event_fd_callback, NULL);
+	g_io_channel_unref(channel);
+
+	wifi_set_device_state_changed_cb(__test_device_state_callback, NULL);
+	wifi_set_background_scan_cb(__test_bg_scan_completed_callback, NULL);
+	wifi_set_connection_state_changed_cb(__test_connection_state_callback, NULL);
+	wifi_set_rssi_level_changed_cb(__test_rssi_level_callback, NULL);
+
+	printf("Wifi init with event fd succeeded, fd : %d\n", fd);
+	return 1;
+}
  
 int  test_wifi_deinit(void)
 {
 	int rv = 0;
 
+	/* The event fd is closed by wifi_deinitialize() */
+	if (event_fd_watch) {
+		g_source_remove(event_fd_watch);
+		event_fd_watch = 0;
+	}
+
 	rv = wifi_deinitialize();
 
 	if (rv != WIFI_ERROR_NONE){
@@ -353,6 +473,35 @@ int test_get_interface_name(void)
 	return 1;
 }
 
+int test_interface_name_benchmark(void)
+{
+	const int iterations = 1000;
+	char *if_name = NULL;
+	gint64 start, first, elapsed;
+	int i;
+
+	start = g_get_monotonic_time();
+	if (wifi_get_network_interface_name(&if_name) != WIFI_ERROR_NONE) {
+		printf("Fail to get Interface name\n");
+		return -1;
+	}
+	first = g_get_monotonic_time() - start;
+	g_free(if_name);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		if (wifi_get_network_interface_name(&if_name) != WIFI_ERROR_NONE)
+			break;
+		g_free(if_name);
+	}
+	elapsed = g_get_monotonic_time() - start;
+
+	printf("First lookup : %lld us\n", (long long)first);
+	printf("Cached lookup : %.2f us\n", (double)elapsed / iterations);
+
+	return 1;
+}
+
 int test_scan_request(void)
 {
 	int rv = 0;
@@ -395,6 +544,107 @@ int test_get_connected_ap(void)
 	return 1;
 }
 
+int test_connected_ap_benchmark(void)
+{
+	const int iterations = 10000;
+	gint64 start, first, repeated;
+	wifi_ap_h ap_h;
+	int rv;
+	int i;
+
+	start = g_get_monotonic_time();
+	rv = wifi_get_connected_ap(&ap_h);
+	first = g_get_monotonic_time() - start;
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get connected AP [%d]\n", rv);
+		return -1;
+	}
+
+	wifi_ap_destroy(ap_h);
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		if (wifi_get_connected_ap(&ap_h) == WIFI_ERROR_NONE)
+			wifi_ap_destroy(ap_h);
+	}
+	repeated = g_get_monotonic_time() - start;
+
+	printf("First lookup : %lld us, repeated lookup : %.1f ns\n",
+			(long long)first, (double)repeated * 1000 / iterations);
+
+	return 1;
+}
+
+static void __test_ap_committed_callback(wifi_error_e result, void *user_data)
+{
+	gint64 *start = user_data;
+
+	printf("IP config applied [%d] after %lld us\n", result,
+			(long long)(g_get_monotonic_time() - *start));
+	g_free(start);
+}
+
+int test_commit_ip_config(bool async)
+{
+	gint64 *async_start = NULL;
+	wifi_ip_config_type_e type;
+	char *ip = NULL, *subnet = NULL, *gateway = NULL, *dns = NULL;
+	gint64 start, elapsed;
+	wifi_ap_h ap_h;
+	int rv;
+
+	rv = wifi_get_connected_ap(&ap_h);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get connected AP [%d]\n", rv);
+		return -1;
+	}
+
+	wifi_ap_get_ip_config_type(ap_h, WIFI_ADDRESS_FAMILY_IPV4, &type);
+	wifi_ap_get_ip_address(ap_h, WIFI_ADDRESS_FAMILY_IPV4, &ip);
+	wifi_ap_get_subnet_mask(ap_h, WIFI_ADDRESS_FAMILY_IPV4, &subnet);
+	wifi_ap_get_gateway_address(ap_h, WIFI_ADDRESS_FAMILY_IPV4, &gateway);
+	wifi_ap_get_dns_address(ap_h, 1, WIFI_ADDRESS_FAMILY_IPV4, &dns);
+
+	/* The current values are written back, so the connection is not changed */
+	start = g_get_monotonic_time();
+	wifi_ap_begin_edit(ap_h);
+	wifi_ap_set_ip_config_type(ap_h, WIFI_ADDRESS_FAMILY_IPV4, type);
+	if (ip)
+		wifi_ap_set_ip_address(ap_h, WIFI_ADDRESS_FAMILY_IPV4, ip);
+	if (subnet)
+		wifi_ap_set_subnet_mask(ap_h, WIFI_ADDRESS_FAMILY_IPV4, subnet);
+	if (gateway)
+		wifi_ap_set_gateway_address(ap_h, WIFI_ADDRESS_FAMILY_IPV4, gateway);
+	if (dns)
+		wifi_ap_set_dns_address(ap_h, 1, WIFI_ADDRESS_FAMILY_IPV4, dns);
+	if (async) {
+		async_start = g_new(gint64, 1);
+		*async_start = start;
+		rv = wifi_ap_commit_async(ap_h, __test_ap_committed_callback, async_start);
+		if (rv != WIFI_ERROR_NONE)
+			g_free(async_start);
+	} else {
+		rv = wifi_ap_commit(ap_h);
+	}
+	elapsed = g_get_monotonic_time() - start;
+
+	g_free(ip);
+	g_free(subnet);
+	g_free(gateway);
+	g_free(dns);
+	wifi_ap_destroy(ap_h);
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to commit IP config [%d]\n", rv);
+		return -1;
+	}
+
+	printf("IP config committed in %lld us\n", (long long)elapsed);
+
+	return 1;
+}
+
 int test_foreach_found_aps(void)
 {
 	int rv = 0;
@@ -410,6 +660,147 @@ int test_foreach_found_aps(void)
 	return 1;
 }
 
+int test_foreach_changed_aps(void)
+{
+	int rv = 0;
+
+	rv = wifi_foreach_changed_aps(__test_changed_ap_callback, NULL);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get changed AP list [%d]\n", rv);
+		return -1;
+	}
+
+	printf("Get changed AP list finished\n");
+
+	return 1;
+}
+
+int test_foreach_strongest_aps(void)
+{
+	int rv = 0;
+
+	rv = wifi_foreach_found_aps_sorted(WIFI_AP_SORT_KEY_RSSI, 5, __test_found_ap_callback, NULL);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get sorted AP list [%d]\n", rv);
+		return -1;
+	}
+
+	printf("Get sorted AP list finished\n");
+
+	return 1;
+}
+
+int test_foreach_filtered_aps(void)
+{
+	int rv = 0;
+	wifi_ap_filter_s filter;
+
+	memset(&filter, 0, sizeof(wifi_ap_filter_s));
+	filter.flags = WIFI_AP_FILTER_FREQUENCY | WIFI_AP_FILTER_SECURITY_TYPE;
+	filter.min_frequency = 4900;
+	filter.max_frequency = 5900;
+	filter.security_types = (1 << WIFI_SECURITY_TYPE_WPA_PSK) |
+			(1 << WIFI_SECURITY_TYPE_WPA2_PSK) |
+			(1 << WIFI_SECURITY_TYPE_EAP);
+
+	rv = wifi_foreach_found_aps_filtered(&filter, __test_found_ap_callback, NULL);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get filtered AP list [%d]\n", rv);
+		return -1;
+	}
+
+	printf("Get filtered AP list finished\n");
+
+	return 1;
+}
+
+static bool __test_count_ap_callback(wifi_ap_h ap, void *user_data)
+{
+	(*(int *)user_data)++;
+	return true;
+}
+
+/* Ranks and filters synthetic profiles through net_profile_info_t and through
+ * the summary, so no daemon is needed */
+int test_summary_benchmark(void)
+{
+	const int counts[] = {1000, 10000};
+	const int iterations = 100;
+	long long profile_us, summary_us;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		if (_wifi_libnet_benchmark_profile_summary(counts[i], iterations,
+				&profile_us, &summary_us) == false) {
+			printf("Summary benchmark failed at %d APs\n", counts[i]);
+			return -1;
+		}
+
+		printf("%5d APs : net_profile_info_t %.2f us/pass, summary %.2f us/pass\n",
+				counts[i], (double)profile_us / iterations,
+				(double)summary_us / iterations);
+	}
+
+	return 1;
+}
+
+static int essid_match_count = 0;
+
+static bool __test_count_essid_callback(wifi_ap_h ap, void *user_data)
+{
+	char *ap_name = NULL;
+
+	if (wifi_ap_get_essid(ap, &ap_name) != WIFI_ERROR_NONE)
+		return true;
+
+	if (strcmp(ap_name, user_data) == 0)
+		essid_match_count++;
+	g_free(ap_name);
+
+	return true;
+}
+
+int test_find_ap_by_essid(void)
+{
+	int rv = 0;
+	char ap_name[33];
+	char *bssid = NULL;
+	wifi_ap_h *aps = NULL;
+	int count = 0;
+	int i;
+
+	printf("Input ESSID to find : ");
+	rv = scanf("%32s", ap_name);
+
+	rv = wifi_get_ap_by_essid(ap_name, &aps, &count);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to find AP [%d]\n", rv);
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (wifi_ap_get_bssid(aps[i], &bssid) == WIFI_ERROR_NONE) {
+			printf("[%d] BSSID : %s\n", i, bssid);
+			g_free(bssid);
+		}
+		__test_found_ap_callback(aps[i], NULL);
+		wifi_ap_destroy(aps[i]);
+	}
+	g_free(aps);
+
+	/* Every AP of the list which shares the ESSID must be returned */
+	essid_match_count = 0;
+	wifi_foreach_found_aps(__test_count_essid_callback, ap_name);
+	if (essid_match_count != count) {
+		printf("Found %d APs, but the list has %d\n", count, essid_match_count);
+		return -1;
+	}
+
+	printf("Find AP finished, %d APs share the ESSID\n", count);
+
+	return 1;
+}
+
 int test_connect_ap(void)
 {
 	int rv = 0;
@@ -428,6 +819,121 @@ int test_connect_ap(void)
 	return 1;
 }
 
+static void __test_request_completed_callback(int request_id, wifi_error_e result,
+		wifi_ap_h ap, void *user_data)
+{
+	char *ap_name = NULL;
+
+	if (ap)
+		wifi_ap_get_essid(ap, &ap_name);
+
+	printf("Request %d completed [%d], AP : %s\n", request_id, result, ap_name ? ap_name : "unknown");
+	g_free(ap_name);
+}
+
+static bool __test_found_connect_ap_async_callback(wifi_ap_h ap, void *user_data)
+{
+	int rv = 0;
+	int request_id = 0;
+	char *ap_name = NULL;
+	char *ap_name_part = (char*)user_data;
+
+	rv = wifi_ap_get_essid(ap, &ap_name);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get AP name [%d]\n", rv);
+		return false;
+	}
+
+	if (strstr(ap_name, ap_name_part) != NULL) {
+		rv = wifi_connect_async(ap, __test_request_completed_callback, NULL, &request_id);
+		if (rv != WIFI_ERROR_NONE)
+			printf("Fail to connect [%s] : %d\n", ap_name, rv);
+		else
+			printf("Request %d started to connect [%s]\n", request_id, ap_name);
+
+		g_free(ap_name);
+		return false;
+	}
+
+	g_free(ap_name);
+	return true;
+}
+
+int test_connect_ap_async(void)
+{
+	int rv = 0;
+	char ap_name[33];
+
+	printf("Input a part of AP name to connect : ");
+	rv = scanf("%32s", ap_name);
+
+	rv = wifi_foreach_found_aps(__test_found_connect_ap_async_callback, ap_name);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to connect (can't get AP list) [%d]\n", rv);
+		return -1;
+	}
+
+	return 1;
+}
+
+int test_event_latency_stats(void)
+{
+	wifi_event_latency_stats_s stats;
+	int rv = wifi_get_event_latency_stats(&stats);
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get event latency stats [%d]\n", rv);
+		return -1;
+	}
+
+	printf("Connection events : %u (profile read in event thread : %u)\n",
+			stats.count, stats.deferred_count);
+	printf("Latency : average %u us, max %u us\n", stats.average_us, stats.max_us);
+
+	wifi_reset_event_latency_stats();
+
+	return 1;
+}
+
+int test_state_event_coalescing(void)
+{
+	wifi_state_event_stats_s stats;
+	int window_ms = 0;
+	int rv;
+
+	rv = wifi_get_state_event_stats(&stats);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to get state event stats [%d]\n", rv);
+		return -1;
+	}
+
+	printf("State indications : received %u, delivered %u\n", stats.received, stats.delivered);
+
+	printf("Input coalescing window in ms (0 to disable) : ");
+	rv = scanf("%d", &window_ms);
+
+	rv = wifi_set_state_event_coalescing(window_ms);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to set coalescing window [%d]\n", rv);
+		return -1;
+	}
+
+	return 1;
+}
+
+int test_get_ap_info_ref(void)
+{
+	int rv = wifi_foreach_found_aps(__test_found_ap_ref_callback, NULL);
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Get AP list failed [%d]\n", rv);
+		return -1;
+	}
+
+	printf("Get AP list finished\n");
+	return 1;
+}
+
 int test_disconnect_ap(void)
 {
 	int rv = 0;
@@ -446,6 +952,313 @@ int test_disconnect_ap(void)
 	return 1;
 }
 
+int test_ap_handle_benchmark(void)
+{
+	const int handle_counts[] = {10, 100, 1000, 10000};
+	const int iterations = 100000;
+	wifi_ap_pool_stats_s stats;
+	int i, j, k;
+	int rssi = 0;
+
+	for (i = 0; i < (int)(sizeof(handle_counts) / sizeof(handle_counts[0])); i++) {
+		wifi_ap_h *handles = g_try_new0(wifi_ap_h, handle_counts[i]);
+		gint64 start, elapsed;
+
+		if (handles == NULL) {
+			printf("Fail to allocate handle array\n");
+			return -1;
+		}
+
+		for (j = 0; j < handle_counts[i]; j++) {
+			if (wifi_ap_create("benchmark", &handles[j]) != WIFI_ERROR_NONE) {
+				printf("Fail to create AP handle [%d]\n", j);
+				break;
+			}
+		}
+
+		if (j == 0) {
+			g_free(handles);
+			return -1;
+		}
+
+		start = g_get_monotonic_time();
+		for (k = 0; k < iterations; k++)
+			wifi_ap_get_rssi(handles[k % j], &rssi);
+		elapsed = g_get_monotonic_time() - start;
+
+		printf("Live handles : %5d, wifi_ap_get_rssi : %.1f ns/call\n",
+				j, (double)elapsed * 1000 / iterations);
+
+		while (j > 0)
+			wifi_ap_destroy(handles[--j]);
+
+		g_free(handles);
+	}
+
+	if (wifi_ap_pool_get_stats(&stats) == WIFI_ERROR_NONE)
+		printf("AP pool : size %d, free %d, in use %d, high water mark %d, hits %u, misses %u\n",
+				stats.pool_size, stats.free_count, stats.in_use,
+				stats.high_water_mark, stats.hits, stats.misses);
+
+	return 1;
+}
+
+int test_ap_info_benchmark(void)
+{
+	const int iterations = 100000;
+	const unsigned int row_fields = WIFI_AP_FIELD_ESSID | WIFI_AP_FIELD_BSSID |
+			WIFI_AP_FIELD_RSSI | WIFI_AP_FIELD_FREQUENCY | WIFI_AP_FIELD_MAX_SPEED |
+			WIFI_AP_FIELD_SECURITY_TYPE | WIFI_AP_FIELD_ENCRYPTION_TYPE | WIFI_AP_FIELD_FAVORITE;
+	wifi_security_type_e security_type;
+	wifi_encryption_type_e encryption_type;
+	wifi_ap_info_s info;
+	wifi_ap_h ap;
+	gint64 start, per_field, bulk;
+	char *essid, *bssid;
+	int rssi, frequency, max_speed;
+	bool favorite;
+	int i;
+
+	if (wifi_ap_create("benchmark", &ap) != WIFI_ERROR_NONE) {
+		printf("Fail to create AP handle\n");
+		return -1;
+	}
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++) {
+		wifi_ap_get_essid(ap, &essid);
+		wifi_ap_get_bssid(ap, &bssid);
+		wifi_ap_get_rssi(ap, &rssi);
+		wifi_ap_get_frequency(ap, &frequency);
+		wifi_ap_get_max_speed(ap, &max_speed);
+		wifi_ap_get_security_type(ap, &security_type);
+		wifi_ap_get_encryption_type(ap, &encryption_type);
+		wifi_ap_is_favorite(ap, &favorite);
+		g_free(essid);
+		g_free(bssid);
+	}
+	per_field = g_get_monotonic_time() - start;
+
+	start = g_get_monotonic_time();
+	for (i = 0; i < iterations; i++)
+		wifi_ap_get_info(ap, &info, row_fields);
+	bulk = g_get_monotonic_time() - start;
+
+	printf("Per-field getters : %.1f ns/row, wifi_ap_get_info : %.1f ns/row\n",
+			(double)per_field * 1000 / iterations, (double)bulk * 1000 / iterations);
+
+	wifi_ap_destroy(ap);
+
+	return 1;
+}
+
+int test_scan_export(void)
+{
+	wifi_ap_info_s *aps = NULL;
+	gint64 start, elapsed;
+	int count = 0;
+	int rv = 0;
+	int i;
+
+	start = g_get_monotonic_time();
+	rv = wifi_scan_export_alloc(&aps, &count);
+	elapsed = g_get_monotonic_time() - start;
+
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to export AP list [%d]\n", rv);
+		return -1;
+	}
+
+	for (i = 0; i < count; i++)
+		printf("AP name : %s, bssid : %s, rssi : %d, frequency : %d\n",
+				aps[i].essid, aps[i].bssid, aps[i].rssi, aps[i].frequency);
+
+	printf("%d APs exported in %lld us\n", count, (long long)elapsed);
+
+	free(aps);
+
+	return 1;
+}
+
+int test_scan_snapshot(void)
+{
+	wifi_scan_snapshot_h snapshot = NULL;
+	wifi_ap_info_s info;
+	wifi_ap_info_s *aps = NULL;
+	FILE *file;
+	int count = 0;
+	int snapshot_count = 0;
+	int mismatch = 0;
+	int rv = 0;
+	int i;
+
+	file = tmpfile();
+	if (file == NULL) {
+		printf("Fail to create a temporary file\n");
+		return -1;
+	}
+
+	rv = wifi_scan_snapshot_write(fileno(file));
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to write scan snapshot [%d]\n", rv);
+		fclose(file);
+		return -1;
+	}
+
+	rv = wifi_scan_snapshot_open(fileno(file), &snapshot);
+	fclose(file);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to open scan snapshot [%d]\n", rv);
+		return -1;
+	}
+
+	rv = wifi_scan_export_alloc(&aps, &count);
+	if (rv != WIFI_ERROR_NONE) {
+		printf("Fail to export AP list [%d]\n", rv);
+		wifi_scan_snapshot_close(snapshot);
+		return -1;
+	}
+
+	wifi_scan_snapshot_get_count(snapshot, &snapshot_count);
+	if (snapshot_count != count)
+		printf("Count mismatch : snapshot %d, scan %d\n", snapshot_count, count);
+
+	for (i = 0; i < snapshot_count && i < count; i++) {
+		if (wifi_scan_snapshot_get_ap_info(snapshot, i, &info) != WIFI_ERROR_NONE ||
+		    memcmp(&info, &aps[i], sizeof(wifi_ap_info_s)) != 0) {
+			printf("Mismatch at %d : snapshot %s, scan %s\n", i, info.essid, aps[i].essid);
+			mismatch++;
+		}
+	}
+
+	printf("%d APs in snapshot, %d mismatched\n", snapshot_count, mismatch);
+
+	free(aps);
+	wifi_scan_snapshot_close(snapshot);
+
+	if (snapshot_count != count || mismatch > 0)
+		return -1;
+
+	return 1;
+}
+
+static gint64 __test_time_to_first_list(bool *stale)
+{
+	gint64 start, elapsed;
+	int ap_count = 0;
+
+	if (test_wifi_deinit() < 0 || test_wifi_init() < 0)
+		return -1;
+
+	start = g_get_monotonic_time();
+	wifi_foreach_found_aps(__test_count_ap_callback, &ap_count);
+	elapsed = g_get_monotonic_time() - start;
+
+	wifi_is_scan_result_stale(stale);
+	printf("First list : %d APs in %lld us%s\n", ap_count, (long long)elapsed,
+			*stale ? " (stale)" : "");
+
+	return elapsed;
+}
+
+int test_scan_cache_startup(void)
+{
+	const char *path = "/tmp/wifi_test_scan_cache";
+	gint64 cold, warm;
+	bool stale = false;
+
+	unlink(path);
+	wifi_set_scan_cache_path(path);
+
+	/* The cold start stores the cache, the warm start serves it */
+	cold = __test_time_to_first_list(&stale);
+	warm = __test_time_to_first_list(&stale);
+
+	wifi_set_scan_cache_path(NULL);
+	unlink(path);
+
+	if (cold < 0 || warm < 0)
+		return -1;
+
+	printf("Time to first list : cold %lld us, warm %lld us\n",
+			(long long)cold, (long long)warm);
+
+	return 1;
+}
+
+static GSList *retained_aps = NULL;
+
+static bool __test_retain_ap_callback(wifi_ap_h ap, void *user_data)
+{
+	wifi_ap_h cloned_ap;
+
+	if (wifi_ap_clone(&cloned_ap, ap) == WIFI_ERROR_NONE)
+		retained_aps = g_slist_prepend(retained_aps, cloned_ap);
+
+	return true;
+}
+
+int test_retain_found_aps(void)
+{
+	int rv = 0;
+	GSList *list;
+	const char *essid;
+
+	if (retained_aps == NULL) {
+		rv = wifi_foreach_found_aps(__test_retain_ap_callback, NULL);
+		if (rv != WIFI_ERROR_NONE) {
+			printf("Fail to get AP list [%d]\n", rv);
+			return -1;
+		}
+
+		printf("%u APs retained, scan and run again to read them back\n",
+				g_slist_length(retained_aps));
+		return 1;
+	}
+
+	for (list = retained_aps; list; list = list->next) {
+		if (wifi_ap_get_essid_ref(list->data, &essid) == WIFI_ERROR_NONE)
+			printf("Retained AP name : %s\n", essid);
+
+		wifi_ap_destroy(list->data);
+	}
+
+	g_slist_free(retained_aps);
+	retained_aps = NULL;
+
+	return 1;
+}
+
+static gpointer __test_reader_thread(gpointer data)
+{
+	const int iterations = 1000;
+	int ap_count = 0;
+	int i;
+
+	for (i = 0; i < iterations; i++)
+		wifi_foreach_found_aps(__test_count_ap_callback, &ap_count);
+
+	printf("Reader thread finished, %d iterations, %d APs read\n", iterations, ap_count);
+
+	return NULL;
+}
+
+int test_read_aps_from_thread(void)
+{
+	GThread *thread;
+	int rv = 0;
+
+	thread = g_thread_new("wifi-test-reader", __test_reader_thread, NULL);
+
+	rv = wifi_scan(__test_scan_request_callback, NULL);
+	if (rv != WIFI_ERROR_NONE)
+		printf("Fail to request scan [%d]\n", rv);
+
+	g_thread_unref(thread);
+
+	return 1;
+}
+
 int main(int argc, char **argv)
 {
 	GMainLoop *mainloop;
@@ -489,6 +1302,28 @@ gboolean test_thread(GIOChannel *source, GIOCondition condition, gpointer data)
 		printf("b 	- Get AP list\n");
 		printf("c 	- Connect\n");
 		printf("d 	- Disconnect\n");
+		printf("e 	- AP handle validation benchmark\n");
+		printf("f 	- Get changed AP list\n");
+		printf("g 	- Find AP by ESSID\n");
+		printf("h 	- Get 5 strongest APs\n");
+		printf("i 	- Get secured 5 GHz APs\n");
+		printf("j 	- Scan summary layout benchmark\n");
+		printf("k 	- Retain found APs / read retained APs\n");
+		printf("l 	- Read AP list from a thread while scanning\n");
+		printf("m 	- AP info benchmark\n");
+		printf("n 	- Export AP list\n");
+		printf("o 	- Scan snapshot round trip\n");
+		printf("p 	- Time to first AP list (cold / warm start)\n");
+		printf("q 	- Connected AP lookup benchmark\n");
+		printf("r 	- Rewrite IP config of connected AP in one commit\n");
+		printf("s 	- Rewrite IP config of connected AP asynchronously\n");
+		printf("t 	- Connect to AP with request ID\n");
+		printf("u 	- Show and reset event latency stats\n");
+		printf("v 	- Coalesce state indications\n");
+		printf("w 	- Initialize wifi with event thread\n");
+		printf("x 	- Initialize wifi with event fd\n");
+		printf("y 	- Get AP list with borrowed strings\n");
+		printf("z 	- Interface name lookup benchmark\n");
 		printf("0 	- Exit \n");
 
 		printf("ENTER  - Show options menu.......\n");
@@ -534,6 +1369,72 @@ gboolean test_thread(GIOChannel *source, GIOCondition condition, gpointer data)
 		case 'd': {
 			rv = test_disconnect_ap();
 		} break;
+		case 'e': {
+			rv = test_ap_handle_benchmark();
+		} break;
+		case 'f': {
+			rv = test_foreach_changed_aps();
+		} break;
+		case 'g': {
+			rv = test_find_ap_by_essid();
+		} break;
+		case 'h': {
+			rv = test_foreach_strongest_aps();
+		} break;
+		case 'i': {
+			rv = test_foreach_filtered_aps();
+		} break;
+		case 'j': {
+			rv = test_summary_benchmark();
+		} break;
+		case 'k': {
+			rv = test_retain_found_aps();
+		} break;
+		case 'l': {
+			rv = test_read_aps_from_thread();
+		} break;
+		case 'm': {
+			rv = test_ap_info_benchmark();
+		} break;
+		case 'n': {
+			rv = test_scan_export();
+		} break;
+		case 'o': {
+			rv = test_scan_snapshot();
+		} break;
+		case 'p': {
+			rv = test_scan_cache_startup();
+		} break;
+		case 'q': {
+			rv = test_connected_ap_benchmark();
+		} break;
+		case 'r': {
+			rv = test_commit_ip_config(false);
+		} break;
+		case 's': {
+			rv = test_commit_ip_config(true);
+		} break;
+		case 't': {
+			rv = test_connect_ap_async();
+		} break;
+		case 'u': {
+			rv = test_event_latency_stats();
+		} break;
+		case 'v': {
+			rv = test_state_event_coalescing();
+		} break;
+		case 'w': {
+			rv = test_wifi_init_with_event_thread();
+		} break;
+		case 'x': {
+			rv = test_wifi_init_with_event_fd();
+		} break;
+		case 'y': {
+			rv = test_get_ap_info_ref();
+		} break;
+		case 'z': {
+			rv = test_interface_name_benchmark();
+		} break;
 	}
 	return TRUE;
 }